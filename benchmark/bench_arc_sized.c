@@ -0,0 +1,127 @@
+/* Records of runtime size kept inline in arc_create_sized list, against
+ *  arl_list of pointers with one allocation per record.
+ *
+ * Usage: bench_arc_sized (<records>) (<record size>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// App
+#include "arc_core.h"
+#include "arl_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_RECORDS 4000000
+#define BENCH_DEFAULT_RECORD_SIZE 40
+#define BENCH_ALIGNMENT 8
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[]) {
+  size_t records = BENCH_DEFAULT_RECORDS,
+         record_size = BENCH_DEFAULT_RECORD_SIZE, i;
+  uint64_t sum_arl = 0, sum_arc = 0, field;
+  unsigned char *record;
+  double start;
+  void *slot;
+  arl_ptr arl;
+  arc_ptr arc;
+
+  if (argc > 1)
+    records = strtoul(argv[1], NULL, 10);
+  if (argc > 2)
+    record_size = strtoul(argv[2], NULL, 10);
+
+  // Each record holds at least it's 8 bytes long key.
+  if (records == 0 || record_size < sizeof(uint64_t))
+    return 1;
+
+  record = calloc(1, record_size);
+  if (!record)
+    return 1;
+
+  if (arl_create(&arl, 16) ||
+      arc_create_sized(&arc, record_size, BENCH_ALIGNMENT, 16))
+    return 1;
+
+  printf("%-8s %-10s %12s\n", "subject", "operation", "seconds");
+
+  // Inline records go first, so they do not reuse heap left by records
+  //  allocated one by one.
+  start = now_seconds();
+  for (i = 0; i < records; i++) {
+    field = i;
+    memcpy(record, &field, sizeof(field));
+    if (arc_append(arc, record))
+      return 1;
+  }
+  printf("%-8s %-10s %12.4f\n", "arc", "append", now_seconds() - start);
+
+  start = now_seconds();
+  for (i = 0; i < records; i++) {
+    void *p = malloc(record_size);
+    if (!p)
+      return 1;
+
+    field = i;
+    memcpy(record, &field, sizeof(field));
+    memcpy(p, record, record_size);
+    if (arl_append(arl, p))
+      return 1;
+  }
+  printf("%-8s %-10s %12.4f\n", "arl", "append", now_seconds() - start);
+
+  start = now_seconds();
+  for (i = 0; i < records; i++) {
+    arl_get(arl, i, &slot);
+    memcpy(&field, slot, sizeof(field));
+    sum_arl += field;
+  }
+  printf("%-8s %-10s %12.4f\n", "arl", "scan", now_seconds() - start);
+
+  start = now_seconds();
+  for (i = 0; i < records; i++) {
+    arc_at(arc, i, &slot);
+    memcpy(&field, slot, sizeof(field));
+    sum_arc += field;
+  }
+  printf("%-8s %-10s %12.4f\n", "arc", "scan", now_seconds() - start);
+
+  if (sum_arl != sum_arc) {
+    fprintf(stderr, "Lists differ!\n");
+    return 1;
+  }
+
+  for (i = 0; i < records; i++) {
+    arl_get(arl, i, &slot);
+    free(slot);
+  }
+
+  arl_destroy(arl);
+  arc_destroy(arc);
+  free(record);
+
+  return 0;
+}
@@ -0,0 +1,214 @@
+/* Deterministic workloads of arl_list's operations, to be counted with
+ *  callgrind by scripts/run_callgrind_tests.sh.
+ *
+ * Every operation runs in it's own `op_<name>` function, list is prepared
+ *  outside of it. Callgrind collects events only inside that function
+ *  (--toggle-collect), so counts do not depend on the setup. Sizes are
+ *  fixed, counts are repeatable between runs of the same build.
+ *
+ * Usage: bench_arl_callgrind <operation>
+ *        bench_arl_callgrind --list
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// App
+#include "arl_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+/* Elements in the list before operation. */
+#define BENCH_SIZE 10000
+/* Calls of the operation. */
+#define BENCH_OPS 1000
+/* Elements per slice or pop_multi call. */
+#define BENCH_BATCH 64
+
+// Measured functions can not be inlined into main, callgrind would not see
+//  them.
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+struct bench_operation {
+  const char *name;
+  // Size of the list prepared for the operation.
+  size_t size;
+  int (*run)(arl_ptr l);
+};
+
+/*******************************************************************************
+ *    OPERATIONS
+ ******************************************************************************/
+BENCH_NOINLINE static int op_append(arl_ptr l) {
+  size_t k;
+
+  // Starts from empty list, growth is counted too.
+  for (k = 0; k < BENCH_SIZE; k++) {
+    if (arl_append(l, (int)k))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_insert_front(arl_ptr l) {
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_insert(l, 0, (int)k))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_insert_middle(arl_ptr l) {
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_insert(l, arl_length(l) / 2, (int)k))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_insert_multi(arl_ptr l) {
+  int values[BENCH_BATCH] = {0};
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_insert_multi(l, arl_length(l) / 2, BENCH_BATCH, values))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_get(arl_ptr l) {
+  size_t k;
+  int value;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_get(l, (k * 7919) % BENCH_SIZE, &value))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_set(arl_ptr l) {
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_set(l, (k * 7919) % BENCH_SIZE, (int)k))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_slice(arl_ptr l) {
+  // Slice writes one element more than asked for.
+  int slice[BENCH_BATCH + 1];
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_slice(l, k, BENCH_BATCH, slice))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_pop(arl_ptr l) {
+  size_t k;
+  int value;
+
+  for (k = 0; k < BENCH_OPS; k++) {
+    if (arl_pop(l, arl_length(l) / 2, &value))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_pop_multi(arl_ptr l) {
+  // Pop multi writes one element more than it pops.
+  int holder[BENCH_BATCH + 1];
+  size_t k;
+
+  for (k = 0; k < BENCH_OPS / 10; k++) {
+    if (arl_pop_multi(l, arl_length(l) / 2, BENCH_BATCH, holder))
+      return 1;
+  }
+
+  return 0;
+}
+
+BENCH_NOINLINE static int op_clear(arl_ptr l) { return arl_clear(l, NULL); }
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static const struct bench_operation BENCH_OPERATIONS[] = {
+    {"append", 0, op_append},
+    {"insert_front", BENCH_SIZE, op_insert_front},
+    {"insert_middle", BENCH_SIZE, op_insert_middle},
+    {"insert_multi", BENCH_SIZE, op_insert_multi},
+    {"get", BENCH_SIZE, op_get},
+    {"set", BENCH_SIZE, op_set},
+    {"slice", BENCH_SIZE, op_slice},
+    {"pop", BENCH_SIZE, op_pop},
+    {"pop_multi", BENCH_SIZE, op_pop_multi},
+    {"clear", BENCH_SIZE, op_clear},
+};
+
+#define BENCH_OPERATIONS_AMOUNT                                                \
+  (sizeof(BENCH_OPERATIONS) / sizeof(struct bench_operation))
+
+int main(int argc, char *argv[]) {
+  const struct bench_operation *operation = NULL;
+  size_t k;
+  arl_ptr l;
+  int err;
+
+  if (argc != 2)
+    return 1;
+
+  for (k = 0; k < BENCH_OPERATIONS_AMOUNT; k++) {
+    if (strcmp(argv[1], "--list") == 0)
+      printf("%s\n", BENCH_OPERATIONS[k].name);
+    else if (strcmp(argv[1], BENCH_OPERATIONS[k].name) == 0)
+      operation = &BENCH_OPERATIONS[k];
+  }
+
+  if (!operation)
+    return strcmp(argv[1], "--list") != 0;
+
+  if (arl_create(&l, 1))
+    return 1;
+
+  for (k = 0; k < operation->size; k++) {
+    if (arl_append(l, (int)k))
+      return 1;
+  }
+
+  err = operation->run(l);
+  if (err)
+    fprintf(stderr, "%s failed\n", operation->name);
+
+  arl_destroy(l);
+
+  return err;
+}
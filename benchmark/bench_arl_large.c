@@ -0,0 +1,151 @@
+/* Random reads from a big arl_list, kept on the heap and in large storage
+ *  (2MB aligned, huge pages requested).
+ *
+ * Reads are measured by the benchmarks' harness (bench_harness.h), data TLB
+ *  misses per read show what huge pages save. Counters may be forbidden
+ *  (see /proc/sys/kernel/perf_event_paranoid) or not virtualized, then they
+ *  are reported as null.
+ *
+ * Usage: bench_arl_large (--elements <n>) (--reads <n>)
+ *                        (--output <file.json>)
+ */
+
+#define _GNU_SOURCE
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "arl_list.h"
+#include "bench_harness.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_ELEMENTS (64 * 1024 * 1024)
+#define BENCH_DEFAULT_READS (16 * 1024 * 1024)
+
+struct bench_subject {
+  const char *operation;
+  arl_error (*create)(arl_ptr *l, size_t elements);
+};
+
+/*******************************************************************************
+ *    SUBJECTS
+ ******************************************************************************/
+static arl_error create_heap(arl_ptr *l, size_t elements) {
+  return arl_create(l, elements);
+}
+
+static arl_error create_large(arl_ptr *l, size_t elements) {
+  return arl_create_large(l, elements, elements);
+}
+
+static const struct bench_subject subjects[] = {
+    {"random_get_heap", create_heap},
+    {"random_get_large", create_large},
+};
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+/* Xorshift, cheap enough not to hide memory latency. */
+static size_t next_index(uint64_t *state, size_t elements) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+
+  return (size_t)(*state % elements);
+}
+
+static int run(struct bench_report *report,
+               const struct bench_subject *subject, size_t elements,
+               size_t reads) {
+  uint64_t state = 88172645463325252u;
+  struct bench_region region;
+  struct bench_result result;
+  size_t i;
+  int value;
+  long long sum = 0;
+  arl_ptr l;
+
+  if (subject->create(&l, elements))
+    return 1;
+
+  for (i = 0; i < elements; i++) {
+    if (arl_append(l, (int)i)) {
+      arl_destroy(l);
+      return 1;
+    }
+  }
+
+  bench_region_start(&region);
+
+  for (i = 0; i < reads; i++) {
+    arl_get(l, next_index(&state, elements), &value);
+    sum += value;
+  }
+
+  bench_region_stop(&region, &result);
+
+  result.operation = subject->operation;
+  result.size = elements;
+  result.ops = reads;
+  bench_report_result(report, &result);
+
+  // Sum keeps reads from being optimized out.
+  if (sum == -1)
+    fprintf(stderr, "%lld\n", sum);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  size_t elements = BENCH_DEFAULT_ELEMENTS, reads = BENCH_DEFAULT_READS, k;
+  const char *output = NULL;
+  struct bench_report report;
+  FILE *file = stdout;
+  int i, err = 0;
+
+  for (i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--elements") == 0)
+      elements = strtoul(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "--reads") == 0)
+      reads = strtoul(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "--output") == 0)
+      output = argv[i + 1];
+    else
+      return 1;
+  }
+
+  if (elements == 0 || reads == 0)
+    return 1;
+
+  if (output) {
+    file = fopen(output, "w");
+    if (!file)
+      return 1;
+  }
+
+  bench_report_begin(&report, file, "arl_large", "int");
+
+  for (k = 0; k < sizeof(subjects) / sizeof(subjects[0]) && !err; k++) {
+    err = run(&report, &subjects[k], elements, reads);
+  }
+
+  bench_report_end(&report);
+
+  if (output)
+    fclose(file);
+
+  return err;
+}
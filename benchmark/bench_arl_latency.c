@@ -0,0 +1,306 @@
+/* Latency of every single arl_list's operation, under mixed workloads and
+ *  for each growth policy. Reports p50, p99, p99.9 and max per operation.
+ *
+ * Amortized O(1) append hides spikes, when growing copies the whole array.
+ *  Lists start empty and grow through all sizes up to `ops` elements, so
+ *  the spikes are in the tails. Growth policies:
+ *    - realloc, `arl_create`, array is copied when moved by realloc,
+ *    - reserved, `arl_create_reserved`, array never moves, pages are
+ *      committed,
+ *    - large, `arl_create_large`, like reserved in 2MB steps,
+ *    - incremental, `arl_create_incremental`, elements are migrated to the
+ *      new array by following inserts.
+ *  Reserved ones need ARL_ENABLE_MMAP, incremental ARL_ENABLE_INCREMENTAL.
+ *
+ * Inserts and pops land in the last BENCH_TAIL elements, shifts stay short
+ *  and do not cover the growth. Indexes are random (fixed seed).
+ *
+ * Usage: bench_arl_latency (--ops <n>) (--output <file.json>)
+ */
+
+#define _GNU_SOURCE
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "arl_list.h"
+#include "bench_histogram.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_OPS 16000000
+/* Inserts and pops are done within that many last elements. */
+#define BENCH_TAIL 64
+
+typedef enum {
+  BENCH_OP_APPEND = 0,
+
+  BENCH_OP_GET,
+
+  BENCH_OP_SET,
+
+  BENCH_OP_INSERT,
+
+  BENCH_OP_POP,
+
+  /* `BENCH_OP_LEN` stands for number of elements in enum. */
+  BENCH_OP_LEN,
+} bench_op;
+
+static const char *const BENCH_OP_NAMES[BENCH_OP_LEN] = {
+    "append", // 0
+    "get",    // 1
+    "set",    // 2
+    "insert", // 3
+    "pop",    // 4
+};
+
+/* Shares of operations in percents, in order of `bench_op`. */
+struct bench_workload {
+  const char *name;
+  unsigned shares[BENCH_OP_LEN];
+};
+
+static const struct bench_workload BENCH_WORKLOADS[] = {
+    {"append_only", {100, 0, 0, 0, 0}},
+    {"read_mostly", {10, 80, 10, 0, 0}},
+    {"mixed", {30, 30, 20, 10, 10}},
+};
+
+struct bench_policy {
+  const char *name;
+  arl_error (*create)(arl_ptr *l, size_t max_capacity);
+};
+
+static arl_error create_realloc(arl_ptr *l, size_t max_capacity) {
+  (void)max_capacity;
+  return arl_create(l, 1);
+}
+
+#ifdef ARL_ENABLE_MMAP
+static arl_error create_reserved(arl_ptr *l, size_t max_capacity) {
+  return arl_create_reserved(l, 1, max_capacity);
+}
+
+static arl_error create_large(arl_ptr *l, size_t max_capacity) {
+  return arl_create_large(l, 1, max_capacity);
+}
+#endif
+
+#ifdef ARL_ENABLE_INCREMENTAL
+static arl_error create_incremental(arl_ptr *l, size_t max_capacity) {
+  (void)max_capacity;
+  return arl_create_incremental(l, 1);
+}
+#endif
+
+static const struct bench_policy BENCH_POLICIES[] = {
+    {"realloc", create_realloc},
+#ifdef ARL_ENABLE_MMAP
+    {"reserved", create_reserved},
+    {"large", create_large},
+#endif
+#ifdef ARL_ENABLE_INCREMENTAL
+    {"incremental", create_incremental},
+#endif
+};
+
+#define BENCH_AMOUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/*******************************************************************************
+ *    UTILS
+ ******************************************************************************/
+/* xorshift64, same sequence every run. */
+static uint64_t next_random(uint64_t *state) {
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+
+  return *state;
+}
+
+static bench_op pick_op(const struct bench_workload *workload, size_t length,
+                        uint64_t *state) {
+  unsigned roll = (unsigned)(next_random(state) % 100), k;
+
+  for (k = 0; k < BENCH_OP_LEN; k++) {
+    if (roll < workload->shares[k])
+      break;
+    roll -= workload->shares[k];
+  }
+
+  // Empty list can only be appended to.
+  if (k == BENCH_OP_LEN || (!length && k != BENCH_OP_INSERT))
+    return BENCH_OP_APPEND;
+
+  return (bench_op)k;
+}
+
+static size_t tail_index(size_t length, uint64_t *state) {
+  size_t tail = length < BENCH_TAIL ? length : BENCH_TAIL;
+
+  return length - tail + (size_t)(next_random(state) % (tail + 1));
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+/* Runs `ops` operations of the workload, each one's latency is recorded in
+ *  histogram of it's kind.
+ */
+static int run(const struct bench_policy *policy,
+               const struct bench_workload *workload, size_t ops,
+               struct bench_histogram histograms[]) {
+  uint64_t state = 0x9e3779b97f4a7c15u, start, end;
+  size_t k, i, length = 0;
+  arl_error err = ARL_SUCCESS;
+  bench_op op = BENCH_OP_APPEND;
+  arl_ptr l;
+  int value;
+
+  if (policy->create(&l, ops))
+    return 1;
+
+  for (k = 0; k < ops && !err; k++) {
+    op = pick_op(workload, length, &state);
+    i = op == BENCH_OP_INSERT || op == BENCH_OP_POP
+            ? tail_index(length, &state)
+            : (size_t)(next_random(&state) % (length ? length : 1));
+    // Pop of the last element index.
+    if (op == BENCH_OP_POP && i == length)
+      i--;
+
+    start = bench_now_ns();
+    switch (op) {
+    case BENCH_OP_APPEND:
+      err = arl_append(l, (int)k);
+      break;
+    case BENCH_OP_GET:
+      err = arl_get(l, i, &value);
+      break;
+    case BENCH_OP_SET:
+      err = arl_set(l, i, (int)k);
+      break;
+    case BENCH_OP_INSERT:
+      err = arl_insert(l, i, (int)k);
+      break;
+    default:
+      err = arl_pop(l, i, &value);
+    }
+    end = bench_now_ns();
+
+    bench_histogram_record(&histograms[op], end - start);
+    length = arl_length(l);
+  }
+
+  arl_destroy(l);
+
+  if (err)
+    fprintf(stderr, "%s failed: %s\n", BENCH_OP_NAMES[op], arl_strerror(err));
+
+  return err != ARL_SUCCESS;
+}
+
+static void report(FILE *file, size_t *results_amount,
+                   const struct bench_policy *policy,
+                   const struct bench_workload *workload,
+                   struct bench_histogram histograms[]) {
+  const struct bench_histogram *h;
+  uint64_t p50, p99, p999;
+  int k;
+
+  for (k = 0; k < BENCH_OP_LEN; k++) {
+    h = &histograms[k];
+    if (!h->total)
+      continue;
+
+    p50 = bench_histogram_percentile(h, 50);
+    p99 = bench_histogram_percentile(h, 99);
+    p999 = bench_histogram_percentile(h, 99.9);
+
+    printf("%-10s %-12s %-8s %12llu %10llu %10llu %10llu %12llu\n",
+           policy->name, workload->name, BENCH_OP_NAMES[k],
+           (unsigned long long)h->total, (unsigned long long)p50,
+           (unsigned long long)p99, (unsigned long long)p999,
+           (unsigned long long)h->max);
+
+    if (!file)
+      continue;
+
+    fprintf(file,
+            "%s\n    {\"policy\": \"%s\", \"workload\": \"%s\", "
+            "\"operation\": \"%s\", \"count\": %llu, \"p50_ns\": %llu, "
+            "\"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+            *results_amount ? "," : "", policy->name, workload->name,
+            BENCH_OP_NAMES[k], (unsigned long long)h->total,
+            (unsigned long long)p50, (unsigned long long)p99,
+            (unsigned long long)p999, (unsigned long long)h->max);
+    (*results_amount)++;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  struct bench_histogram *histograms;
+  size_t ops = BENCH_DEFAULT_OPS, results_amount = 0, p, w;
+  const char *output = NULL;
+  FILE *file = NULL;
+  int i, k, err = 0;
+
+  for (i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--ops") == 0)
+      ops = strtoul(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "--output") == 0)
+      output = argv[i + 1];
+    else
+      return 1;
+  }
+
+  // Histograms take tens of KBs each.
+  histograms = malloc(BENCH_OP_LEN * sizeof(struct bench_histogram));
+  if (!histograms)
+    return 1;
+
+  if (output) {
+    file = fopen(output, "w");
+    if (!file) {
+      free(histograms);
+      return 1;
+    }
+    fprintf(file, "{\n  \"benchmark\": \"arl_latency\",\n  \"ops\": %zu,\n",
+            ops);
+    fprintf(file, "  \"results\": [");
+  }
+
+  printf("%-10s %-12s %-8s %12s %10s %10s %10s %12s\n", "policy", "workload",
+         "op", "count", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+
+  for (p = 0; p < BENCH_AMOUNT(BENCH_POLICIES) && !err; p++) {
+    for (w = 0; w < BENCH_AMOUNT(BENCH_WORKLOADS) && !err; w++) {
+      for (k = 0; k < BENCH_OP_LEN; k++)
+        bench_histogram_init(&histograms[k]);
+
+      err = run(&BENCH_POLICIES[p], &BENCH_WORKLOADS[w], ops, histograms);
+      if (!err)
+        report(file, &results_amount, &BENCH_POLICIES[p], &BENCH_WORKLOADS[w],
+               histograms);
+    }
+  }
+
+  if (file) {
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+  }
+
+  free(histograms);
+
+  return err;
+}
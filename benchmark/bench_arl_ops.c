@@ -0,0 +1,362 @@
+/* Time of arl_list's operations for one element type, over sizes from 10
+ *  to 100M elements. Results are written as JSON, for
+ *  scripts/compare_benchmarks.py.
+ *
+ * Meson builds one executable per element type (char, int, double, void *,
+ *  64 bytes structure). Operations costing O(n) each are repeated fewer
+ *  times on bigger lists, so every size takes similar time. Hardware
+ *  counters are reported next to the time, when available (bench_harness.h).
+ *
+ * Usage: bench_arl_ops (--sizes <n,n,...>) (--max-bytes <bytes>)
+ *                      (--output <file.json>)
+ */
+
+#define _GNU_SOURCE
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Structure element, defined before the list, which is included directly
+ *  (like in tests) so any type can be used.
+ */
+struct bench_record {
+  unsigned char bytes[64];
+};
+
+// App
+#include "arl_list.c"
+#include "bench_harness.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_SIZES "10,1000,100000,10000000,100000000"
+#define BENCH_DEFAULT_MAX_BYTES ((size_t)1 << 30)
+#define BENCH_SIZES_MAX 32
+
+/* Repetitions of cheap operations. */
+#define BENCH_OPS_MAX 1000
+/* Elements moved by repetitions of O(n) operations, together. */
+#define BENCH_LINEAR_WORK 100000000
+/* Elements per slice or pop_multi call. */
+#define BENCH_BATCH 64
+
+#define BENCH_STRINGIFY(x) #x
+#define BENCH_TO_STRING(x) BENCH_STRINGIFY(x)
+
+/*******************************************************************************
+ *    UTILS
+ ******************************************************************************/
+/* Any type's value, from the index's bytes. */
+static ARL_VALUE_TYPE make_value(size_t i) {
+  ARL_VALUE_TYPE value;
+
+  memset(&value, (int)(i & 0xff), sizeof(value));
+
+  return value;
+}
+
+/* Repetitions of operation which moves up to `size` elements each time. */
+static size_t linear_ops(size_t size) {
+  size_t ops = BENCH_LINEAR_WORK / (size ? size : 1);
+
+  if (ops > BENCH_OPS_MAX)
+    ops = BENCH_OPS_MAX;
+
+  return ops ? ops : 1;
+}
+
+static int fill(arl_ptr *l, size_t size) {
+  size_t i;
+
+  if (arl_create(l, size ? size : 1))
+    return 1;
+
+  for (i = 0; i < size; i++) {
+    if (arl_append(*l, make_value(i)))
+      return 1;
+  }
+
+  return 0;
+}
+
+/*******************************************************************************
+ *    OPERATIONS
+ ******************************************************************************/
+static int bench_create(struct bench_result *result) {
+  struct bench_region region;
+  arl_ptr l;
+  size_t k;
+
+  result->ops = BENCH_OPS_MAX;
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    if (arl_create(&l, result->size ? result->size : 1))
+      return 1;
+    arl_destroy(l);
+  }
+  bench_region_stop(&region, result);
+
+  return 0;
+}
+
+static int bench_append(struct bench_result *result) {
+  struct bench_region region;
+  arl_ptr l;
+  size_t k;
+
+  if (arl_create(&l, 1))
+    return 1;
+
+  result->ops = result->size;
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    if (arl_append(l, make_value(k)))
+      return 1;
+  }
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+/* Inserts at the front (0), middle (1) or back (2) of the list.
+ */
+static int bench_insert(struct bench_result *result, int where) {
+  struct bench_region region;
+  size_t k, i;
+  arl_ptr l;
+
+  if (fill(&l, result->size))
+    return 1;
+
+  result->ops = where == 2 ? BENCH_OPS_MAX : linear_ops(result->size);
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    i = where == 0 ? 0 : where == 1 ? arl_length(l) / 2 : arl_length(l);
+    if (arl_insert(l, i, make_value(k)))
+      return 1;
+  }
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+static int bench_pop(struct bench_result *result) {
+  struct bench_region region;
+  ARL_VALUE_TYPE value;
+  arl_ptr l;
+  size_t k;
+
+  if (fill(&l, result->size))
+    return 1;
+
+  result->ops = linear_ops(result->size);
+  if (result->ops > result->size)
+    result->ops = result->size;
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    if (arl_pop(l, arl_length(l) / 2, &value))
+      return 1;
+  }
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+static int bench_pop_multi(struct bench_result *result) {
+  // Pop multi writes one element more than it pops.
+  ARL_VALUE_TYPE holder[BENCH_BATCH + 1];
+  struct bench_region region;
+  arl_ptr l;
+  size_t k;
+
+  if (fill(&l, result->size))
+    return 1;
+
+  result->ops = linear_ops(result->size);
+  if (result->ops > result->size / (BENCH_BATCH + 1))
+    result->ops = result->size / (BENCH_BATCH + 1);
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    if (arl_pop_multi(l, arl_length(l) / 2 - BENCH_BATCH / 2, BENCH_BATCH,
+                      holder))
+      return 1;
+  }
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+static int bench_slice(struct bench_result *result) {
+  // Slice writes one element more than asked for.
+  ARL_VALUE_TYPE slice[BENCH_BATCH + 1];
+  struct bench_region region;
+  arl_ptr l;
+  size_t k;
+
+  if (fill(&l, result->size))
+    return 1;
+
+  result->ops = result->size > BENCH_BATCH + 1 ? BENCH_OPS_MAX : 0;
+
+  bench_region_start(&region);
+  for (k = 0; k < result->ops; k++) {
+    if (arl_slice(l, k % (result->size - BENCH_BATCH - 1), BENCH_BATCH,
+                  slice))
+      return 1;
+  }
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+static int bench_clear(struct bench_result *result) {
+  struct bench_region region;
+  arl_ptr l;
+
+  if (fill(&l, result->size))
+    return 1;
+
+  result->ops = 1;
+
+  bench_region_start(&region);
+  if (arl_clear(l, NULL))
+    return 1;
+  bench_region_stop(&region, result);
+
+  arl_destroy(l);
+
+  return 0;
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static int bench_size(struct bench_report *report, size_t size) {
+  const char *operations[] = {"create",        "append",      "insert_front",
+                              "insert_middle", "insert_back", "pop",
+                              "pop_multi",     "slice",       "clear"};
+  struct bench_result result;
+  size_t k;
+  int err;
+
+  for (k = 0; k < sizeof(operations) / sizeof(char *); k++) {
+    result.operation = operations[k];
+    result.size = size;
+    result.ops = 0;
+    result.seconds = 0;
+    memset(result.counters, -1, sizeof(result.counters));
+
+    switch (k) {
+    case 0:
+      err = bench_create(&result);
+      break;
+    case 1:
+      err = bench_append(&result);
+      break;
+    case 2:
+    case 3:
+    case 4:
+      err = bench_insert(&result, (int)k - 2);
+      break;
+    case 5:
+      err = bench_pop(&result);
+      break;
+    case 6:
+      err = bench_pop_multi(&result);
+      break;
+    case 7:
+      err = bench_slice(&result);
+      break;
+    default:
+      err = bench_clear(&result);
+    }
+
+    if (err) {
+      fprintf(stderr, "%s failed for size %zu\n", operations[k], size);
+      return 1;
+    }
+
+    bench_report_result(report, &result);
+  }
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  const char *sizes_arg = BENCH_DEFAULT_SIZES, *output = NULL;
+  size_t sizes[BENCH_SIZES_MAX], sizes_amount = 0,
+         max_bytes = BENCH_DEFAULT_MAX_BYTES, k;
+  struct bench_report report;
+  FILE *file = stdout;
+  char *end;
+  int i;
+
+  for (i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--sizes") == 0)
+      sizes_arg = argv[i + 1];
+    else if (strcmp(argv[i], "--max-bytes") == 0)
+      max_bytes = strtoul(argv[i + 1], NULL, 10);
+    else if (strcmp(argv[i], "--output") == 0)
+      output = argv[i + 1];
+    else
+      return 1;
+  }
+
+  while (*sizes_arg && sizes_amount < BENCH_SIZES_MAX) {
+    sizes[sizes_amount] = strtoul(sizes_arg, &end, 10);
+    if (end == sizes_arg)
+      return 1;
+
+    // Sizes not fitting in memory limit are skipped.
+    if (sizes[sizes_amount] <= max_bytes / ARL_VALUE_SIZE)
+      sizes_amount++;
+    else
+      fprintf(stderr, "Skipping size %zu, over %zu bytes\n",
+              sizes[sizes_amount], max_bytes);
+
+    sizes_arg = *end == ',' ? end + 1 : end;
+  }
+
+  if (output) {
+    file = fopen(output, "w");
+    if (!file)
+      return 1;
+  }
+
+  bench_report_begin(&report, file, "arl_ops",
+                     BENCH_TO_STRING(ARL_VALUE_TYPE));
+
+  for (k = 0; k < sizes_amount; k++) {
+    if (bench_size(&report, sizes[k]))
+      return 1;
+  }
+
+  bench_report_end(&report);
+
+  if (output)
+    fclose(file);
+
+  return 0;
+}
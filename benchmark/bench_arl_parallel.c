@@ -0,0 +1,135 @@
+/* Speedup of arl_list's parallel sort and map against one thread.
+ *
+ * Every run works on the same pseudo random floats, so results of
+ *  different threads amounts are comparable.
+ *
+ * Usage: bench_arl_parallel (<max threads>) (<elements>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// App
+#include "arl_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_MAX_THREADS 32
+#define BENCH_DEFAULT_ELEMENTS 16000000
+
+struct bench_subject {
+  const char *name;
+  void (*operation)(arl_ptr l);
+};
+
+static float *values;
+static size_t values_length;
+
+/*******************************************************************************
+ *    SUBJECTS
+ ******************************************************************************/
+static int compare_floats(const void *a, const void *b) {
+  float a_value = *(const float *)a, b_value = *(const float *)b;
+
+  return (a_value > b_value) - (a_value < b_value);
+}
+
+static float scale(float value, void *arg) {
+  (void)arg;
+
+  return value * 1.5f + 1.0f;
+}
+
+static void noop(float value, void *arg) {
+  (void)value;
+  (void)arg;
+}
+
+static void sort_operation(arl_ptr l) { arl_parallel_sort(l, compare_floats); }
+static void map_operation(arl_ptr l) { arl_parallel_map(l, scale, NULL); }
+
+static const struct bench_subject subjects[] = {
+    {"parallel_sort", sort_operation},
+    {"parallel_map", map_operation},
+};
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(const struct bench_subject *subject, size_t threads_amount) {
+  double start, elapsed;
+  arl_ptr l;
+
+  arl_create(&l, values_length);
+  arl_insert_multi(l, 0, values_length, values);
+
+  arl_parallel_set_threads(threads_amount);
+  // Pool is started lazily, do not count threads' creation.
+  arl_parallel_foreach(l, noop, NULL);
+
+  start = now_seconds();
+  subject->operation(l);
+  elapsed = now_seconds() - start;
+
+  arl_destroy(l);
+
+  return elapsed;
+}
+
+int main(int argc, char *argv[]) {
+  size_t max_threads = BENCH_MAX_THREADS, threads_amount, i, k;
+  double elapsed, baseline[sizeof(subjects) / sizeof(subjects[0])];
+
+  values_length = BENCH_DEFAULT_ELEMENTS;
+
+  if (argc > 1)
+    max_threads = strtoul(argv[1], NULL, 10);
+  if (argc > 2)
+    values_length = strtoul(argv[2], NULL, 10);
+
+  if (max_threads == 0 || max_threads > BENCH_MAX_THREADS)
+    max_threads = BENCH_MAX_THREADS;
+
+  values = malloc(values_length * sizeof(float));
+  if (!values)
+    return 1;
+
+  srand(13);
+  for (i = 0; i < values_length; i++) {
+    values[i] = (float)rand() / RAND_MAX;
+  }
+
+  printf("%-16s %8s %12s %12s\n", "subject", "threads", "seconds", "speedup");
+
+  for (threads_amount = 1; threads_amount <= max_threads; threads_amount *= 2) {
+    for (k = 0; k < sizeof(subjects) / sizeof(subjects[0]); k++) {
+      elapsed = run(&subjects[k], threads_amount);
+      if (threads_amount == 1)
+        baseline[k] = elapsed;
+
+      printf("%-16s %8zu %12.4f %12.2f\n", subjects[k].name, threads_amount,
+             elapsed, baseline[k] / elapsed);
+    }
+  }
+
+  free(values);
+
+  return 0;
+}
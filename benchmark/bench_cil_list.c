@@ -0,0 +1,132 @@
+/* Memory and scan speed of compressed integer list against arl_list, both
+ *  holding the same sorted 64 bit IDs.
+ *
+ * Usage: bench_cil_list (<elements>) (<average gap between IDs>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// App
+#include "arl_list.h"
+#include "cil_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_ELEMENTS 16000000
+#define BENCH_DEFAULT_GAP 20
+#define BENCH_GETS 4000000
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void sum_callback(int64_t value, void *arg) { *(int64_t *)arg += value; }
+
+static void print_result(const char *subject, const char *operation,
+                         double seconds, size_t bytes, size_t elements) {
+  printf("%-8s %-10s %12.4f %14zu %10.2f\n", subject, operation, seconds,
+         bytes, (double)bytes / elements);
+}
+
+int main(int argc, char *argv[]) {
+  size_t elements = BENCH_DEFAULT_ELEMENTS, gap = BENCH_DEFAULT_GAP, i,
+         block_i, values_amount;
+  int64_t value, id = 1000000000000, sum_arl = 0, sum_cil = 0,
+                 block[CIL_BLOCK_LENGTH];
+  double start;
+  arl_ptr arl;
+  cil_ptr cil;
+
+  if (argc > 1)
+    elements = strtoul(argv[1], NULL, 10);
+  if (argc > 2)
+    gap = strtoul(argv[2], NULL, 10);
+
+  if (elements == 0 || gap == 0)
+    return 1;
+
+  if (arl_create(&arl, elements) || cil_create(&cil))
+    return 1;
+
+  srand(13);
+  for (i = 0; i < elements; i++) {
+    id += 1 + rand() % (2 * gap);
+    if (arl_append(arl, id) || cil_append(cil, id))
+      return 1;
+  }
+
+  printf("%-8s %-10s %12s %14s %10s\n", "subject", "operation", "seconds",
+         "bytes", "bytes/elem");
+
+  start = now_seconds();
+  for (i = 0; i < elements; i++) {
+    arl_get(arl, i, &value);
+    sum_arl += value;
+  }
+  print_result("arl", "scan", now_seconds() - start,
+               elements * sizeof(int64_t), elements);
+
+  start = now_seconds();
+  for (block_i = 0; block_i < cil_blocks_amount(cil); block_i++) {
+    cil_decode_block(cil, block_i, block, &values_amount);
+    for (i = 0; i < values_amount; i++) {
+      sum_cil += block[i];
+    }
+  }
+  print_result("cil", "scan", now_seconds() - start, cil_memory_usage(cil),
+               elements);
+
+  start = now_seconds();
+  sum_cil = 0;
+  cil_foreach(cil, sum_callback, &sum_cil);
+  print_result("cil", "foreach", now_seconds() - start, cil_memory_usage(cil),
+               elements);
+
+  if (sum_arl != sum_cil) {
+    fprintf(stderr, "Lists differ!\n");
+    return 1;
+  }
+
+  start = now_seconds();
+  for (i = 0; i < BENCH_GETS; i++) {
+    arl_get(arl, (i * 7919) % elements, &value);
+    sum_arl += value;
+  }
+  print_result("arl", "get", now_seconds() - start,
+               elements * sizeof(int64_t), elements);
+
+  start = now_seconds();
+  for (i = 0; i < BENCH_GETS; i++) {
+    cil_get(cil, (i * 7919) % elements, &value);
+    sum_cil += value;
+  }
+  print_result("cil", "get", now_seconds() - start, cil_memory_usage(cil),
+               elements);
+
+  // Sums keep reads from being optimized out.
+  if (sum_arl == -1 || sum_cil == -1)
+    printf("%lld\n", (long long)(sum_arl + sum_cil));
+
+  arl_destroy(arl);
+  cil_destroy(cil);
+
+  return 0;
+}
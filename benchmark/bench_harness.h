@@ -0,0 +1,309 @@
+/* Benchmarks' harness. Measured regions and JSON report, shared by */
+/*  benchmarks comparing runs with scripts/compare_benchmarks.py.   */
+
+/* On Linux hardware counters (cycles, instructions, L1 data and last level
+ *  cache misses, data TLB misses, branch misses) of the calling thread are
+ *  read around every region with perf_event_open. Counters may be forbidden
+ *  (see /proc/sys/kernel/perf_event_paranoid) or not virtualized, then they
+ *  are reported as null, one by one, and only the time is measured.
+ * Benchmark including this header has to define _GNU_SOURCE (syscall).
+ */
+
+#ifndef _bench_harness_h
+#define _bench_harness_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#define BENCH_ENABLE_COUNTERS
+
+// Linux
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  BENCH_COUNTER_CYCLES = 0,
+
+  BENCH_COUNTER_INSTRUCTIONS,
+
+  BENCH_COUNTER_L1D_MISSES,
+
+  BENCH_COUNTER_LLC_MISSES,
+
+  BENCH_COUNTER_DTLB_MISSES,
+
+  BENCH_COUNTER_BRANCH_MISSES,
+
+  /* `BENCH_COUNTER_LEN` stands for number of elements in enum. */
+  BENCH_COUNTER_LEN,
+} bench_counter;
+
+static const char *const BENCH_COUNTER_NAMES[BENCH_COUNTER_LEN] = {
+    "cycles",        // 0
+    "instructions",  // 1
+    "l1d_misses",    // 2
+    "llc_misses",    // 3
+    "dtlb_misses",   // 4
+    "branch_misses", // 5
+};
+
+/* One measured region. */
+struct bench_region {
+  double start;
+};
+
+/* Result of a region, `ops` operations done in `seconds`. Counters not
+ *  available are -1.
+ */
+struct bench_result {
+  const char *operation;
+  size_t size;
+  size_t ops;
+  double seconds;
+  int64_t counters[BENCH_COUNTER_LEN];
+};
+
+/* JSON report, written as results come. */
+struct bench_report {
+  FILE *file;
+  size_t results_amount;
+};
+
+/*******************************************************************************
+ *    COUNTERS
+ ******************************************************************************/
+/* Counters' descriptors, opened with the report, -1 if not available. */
+static int bench_counter_fds[BENCH_COUNTER_LEN] = {-1, -1, -1, -1, -1, -1};
+
+#ifdef BENCH_ENABLE_COUNTERS
+static int bench_counter_open(bench_counter counter) {
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Counters are multiplexed if there are not enough of them in hardware,
+  //  times allow scaling the values.
+  attr.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  switch (counter) {
+  case BENCH_COUNTER_CYCLES:
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    break;
+  case BENCH_COUNTER_INSTRUCTIONS:
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    break;
+  case BENCH_COUNTER_L1D_MISSES:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_L1D |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    break;
+  case BENCH_COUNTER_LLC_MISSES:
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    break;
+  case BENCH_COUNTER_DTLB_MISSES:
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    break;
+  default:
+    attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+  }
+
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+/* Opens all counters, returns amount of available ones. */
+static int bench_counters_open(void) {
+  int available = 0;
+#ifdef BENCH_ENABLE_COUNTERS
+  int k;
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+    bench_counter_fds[k] = bench_counter_open((bench_counter)k);
+    available += bench_counter_fds[k] >= 0;
+  }
+#endif
+
+  return available;
+}
+
+static void bench_counters_close(void) {
+  int k;
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+#ifdef BENCH_ENABLE_COUNTERS
+    if (bench_counter_fds[k] >= 0)
+      close(bench_counter_fds[k]);
+#endif
+    bench_counter_fds[k] = -1;
+  }
+}
+
+static void bench_counters_start(void) {
+#ifdef BENCH_ENABLE_COUNTERS
+  int k;
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+    if (bench_counter_fds[k] < 0)
+      continue;
+
+    ioctl(bench_counter_fds[k], PERF_EVENT_IOC_RESET, 0);
+    ioctl(bench_counter_fds[k], PERF_EVENT_IOC_ENABLE, 0);
+  }
+#endif
+}
+
+static void bench_counters_stop(int64_t counters[]) {
+  int k;
+#ifdef BENCH_ENABLE_COUNTERS
+  // Value, time enabled, time running.
+  uint64_t values[3];
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+    if (bench_counter_fds[k] >= 0)
+      ioctl(bench_counter_fds[k], PERF_EVENT_IOC_DISABLE, 0);
+  }
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+    counters[k] = -1;
+
+    if (bench_counter_fds[k] < 0 ||
+        read(bench_counter_fds[k], values, sizeof(values)) != sizeof(values))
+      continue;
+
+    // Never scheduled, ex. taken by other process.
+    if (!values[2])
+      continue;
+
+    counters[k] = (int64_t)((double)values[0] * values[1] / values[2]);
+  }
+#else
+  for (k = 0; k < BENCH_COUNTER_LEN; k++)
+    counters[k] = -1;
+#endif
+}
+
+/*******************************************************************************
+ *    REGIONS
+ ******************************************************************************/
+static double bench_now(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_region_start(struct bench_region *region) {
+  bench_counters_start();
+  region->start = bench_now();
+}
+
+static void bench_region_stop(struct bench_region *region,
+                              struct bench_result *result) {
+  result->seconds = bench_now() - region->start;
+  bench_counters_stop(result->counters);
+}
+
+/*******************************************************************************
+ *    REPORT
+ ******************************************************************************/
+/* Starts report of `benchmark` for elements of `type`. Report goes to the
+ *  file, results are echoed to stderr for humans. Opens counters.
+ */
+static void bench_report_begin(struct bench_report *report, FILE *file,
+                               const char *benchmark, const char *type) {
+  report->file = file;
+  report->results_amount = 0;
+
+  if (bench_counters_open() < BENCH_COUNTER_LEN)
+    fprintf(stderr, "Some counters are not available, reported as null "
+                    "(see /proc/sys/kernel/perf_event_paranoid)\n");
+
+  fprintf(file, "{\n  \"benchmark\": \"%s\",\n  \"type\": \"%s\",\n", benchmark,
+          type);
+  fprintf(file, "  \"results\": [");
+
+  fprintf(stderr, "%-18s %12s %12s %14s %12s %12s %8s %12s %13s\n",
+          "operation", "size", "ops", "seconds", "ns/op", "cycles/op", "ipc",
+          "l1d miss/op", "dtlb miss/op");
+}
+
+/* Writes the result, counters are totals for the region, per operation
+ *  values are echoed to stderr ("n/a" if not available).
+ */
+static void bench_report_result(struct bench_report *report,
+                                const struct bench_result *result) {
+  const int64_t *counters = result->counters;
+  double ns_per_op = result->ops ? result->seconds * 1e9 / result->ops : 0;
+  char cycles[16] = "n/a", ipc[16] = "n/a", l1d[16] = "n/a", dtlb[16] = "n/a";
+  int k;
+
+  fprintf(report->file,
+          "%s\n    {\"operation\": \"%s\", \"size\": %zu, \"ops\": %zu, "
+          "\"seconds\": %.9f, \"ns_per_op\": %.3f, \"counters\": {",
+          report->results_amount ? "," : "", result->operation, result->size,
+          result->ops, result->seconds, ns_per_op);
+
+  for (k = 0; k < BENCH_COUNTER_LEN; k++) {
+    fprintf(report->file, "%s\"%s\": ", k ? ", " : "", BENCH_COUNTER_NAMES[k]);
+    if (counters[k] < 0)
+      fprintf(report->file, "null");
+    else
+      fprintf(report->file, "%lld", (long long)counters[k]);
+  }
+
+  fprintf(report->file, "}}");
+  report->results_amount++;
+
+  if (result->ops && counters[BENCH_COUNTER_CYCLES] >= 0)
+    snprintf(cycles, sizeof(cycles), "%.1f",
+             (double)counters[BENCH_COUNTER_CYCLES] / result->ops);
+  if (counters[BENCH_COUNTER_CYCLES] > 0 &&
+      counters[BENCH_COUNTER_INSTRUCTIONS] >= 0)
+    snprintf(ipc, sizeof(ipc), "%.2f",
+             (double)counters[BENCH_COUNTER_INSTRUCTIONS] /
+                 counters[BENCH_COUNTER_CYCLES]);
+  if (result->ops && counters[BENCH_COUNTER_L1D_MISSES] >= 0)
+    snprintf(l1d, sizeof(l1d), "%.2f",
+             (double)counters[BENCH_COUNTER_L1D_MISSES] / result->ops);
+  if (result->ops && counters[BENCH_COUNTER_DTLB_MISSES] >= 0)
+    snprintf(dtlb, sizeof(dtlb), "%.3f",
+             (double)counters[BENCH_COUNTER_DTLB_MISSES] / result->ops);
+
+  fprintf(stderr, "%-18s %12zu %12zu %14.6f %12.3f %12s %8s %12s %13s\n",
+          result->operation, result->size, result->ops, result->seconds,
+          ns_per_op, cycles, ipc, l1d, dtlb);
+}
+
+/* Ends the report, closes counters. */
+static void bench_report_end(struct bench_report *report) {
+  fprintf(report->file, "\n  ]\n}\n");
+  fflush(report->file);
+
+  bench_counters_close();
+}
+
+#endif
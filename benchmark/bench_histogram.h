@@ -0,0 +1,135 @@
+/* Latency histogram in the manner of HdrHistogram. Values (ns) are kept in */
+/*  log-linear buckets, with fixed relative precision over the whole range. */
+
+/* Values below BENCH_HISTOGRAM_SUB_COUNT are exact. Above it, every power of
+ *  two range is split into SUB_COUNT / 2 buckets, so a recorded value is
+ *  reported within 1 / (SUB_COUNT / 2) of itself (0.8%). Recording is two
+ *  shifts and an increment, cheap enough to time every operation.
+ * Values over 2^BENCH_HISTOGRAM_MAX_BITS ns (~18 minutes) fall into the last
+ *  bucket, maximum is kept exact.
+ */
+
+#ifndef _bench_histogram_h
+#define _bench_histogram_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define BENCH_HISTOGRAM_SUB_BITS 8
+#define BENCH_HISTOGRAM_SUB_COUNT (1 << BENCH_HISTOGRAM_SUB_BITS)
+#define BENCH_HISTOGRAM_MAX_BITS 40
+#define BENCH_HISTOGRAM_BUCKETS                                                \
+  (BENCH_HISTOGRAM_SUB_COUNT +                                                 \
+   (BENCH_HISTOGRAM_MAX_BITS - BENCH_HISTOGRAM_SUB_BITS + 1) *                 \
+       (BENCH_HISTOGRAM_SUB_COUNT / 2))
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+struct bench_histogram {
+  uint64_t counts[BENCH_HISTOGRAM_BUCKETS];
+  uint64_t total;
+  uint64_t min;
+  uint64_t max;
+};
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_histogram_init(struct bench_histogram *h) {
+  memset(h, 0, sizeof(*h));
+  h->min = UINT64_MAX;
+}
+
+/* Shift of bucket's range holding the value, 0 for exact values. */
+static unsigned bench_histogram_shift(uint64_t value) {
+  unsigned msb = 0;
+
+  if (value < BENCH_HISTOGRAM_SUB_COUNT)
+    return 0;
+
+  while (value >> (msb + 1))
+    msb++;
+
+  return msb - BENCH_HISTOGRAM_SUB_BITS + 1;
+}
+
+static size_t bench_histogram_index(uint64_t value) {
+  unsigned shift;
+
+  if (value >> BENCH_HISTOGRAM_MAX_BITS)
+    return BENCH_HISTOGRAM_BUCKETS - 1;
+
+  shift = bench_histogram_shift(value);
+  if (!shift)
+    return (size_t)value;
+
+  // (value >> shift) is in upper half of sub buckets.
+  return BENCH_HISTOGRAM_SUB_COUNT +
+         (shift - 1) * (BENCH_HISTOGRAM_SUB_COUNT / 2) +
+         (size_t)(value >> shift) - BENCH_HISTOGRAM_SUB_COUNT / 2;
+}
+
+/* Highest value reported for bucket at the index. */
+static uint64_t bench_histogram_highest(size_t index) {
+  unsigned shift;
+  uint64_t sub;
+
+  if (index < BENCH_HISTOGRAM_SUB_COUNT)
+    return index;
+
+  index -= BENCH_HISTOGRAM_SUB_COUNT;
+  shift = (unsigned)(index / (BENCH_HISTOGRAM_SUB_COUNT / 2)) + 1;
+  sub = index % (BENCH_HISTOGRAM_SUB_COUNT / 2) + BENCH_HISTOGRAM_SUB_COUNT / 2;
+
+  return ((sub + 1) << shift) - 1;
+}
+
+static void bench_histogram_record(struct bench_histogram *h, uint64_t value) {
+  h->counts[bench_histogram_index(value)]++;
+  h->total++;
+
+  if (value < h->min)
+    h->min = value;
+  if (value > h->max)
+    h->max = value;
+}
+
+/* Value at or below which `percentile` (0-100) of recorded values are. */
+static uint64_t bench_histogram_percentile(const struct bench_histogram *h,
+                                           double percentile) {
+  uint64_t target, seen = 0, value;
+  size_t k;
+
+  if (!h->total)
+    return 0;
+
+  target = (uint64_t)(percentile / 100 * h->total + 0.5);
+  if (target < 1)
+    target = 1;
+
+  for (k = 0; k < BENCH_HISTOGRAM_BUCKETS; k++) {
+    seen += h->counts[k];
+    if (seen >= target)
+      break;
+  }
+
+  value = bench_histogram_highest(k);
+
+  return value < h->max ? value : h->max;
+}
+
+#endif
@@ -0,0 +1,162 @@
+/* Scaling benchmark of mpq_queue against arl_list guarded by a mutex.
+ *
+ * Every thread pushes one value and pops one value in a loop, so the workload
+ *  is the same for any threads amount (also for a single thread). Total
+ *  amount of operations is constant, what changes is how many threads share
+ *  it.
+ *
+ * Usage: bench_mpq_queue (<max threads>) (<operations>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// App
+#include "arl_list.h"
+#include "mpq_queue.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_MAX_THREADS 64
+#define BENCH_DEFAULT_OPERATIONS 4000000
+#define BENCH_QUEUE_CAPACITY 1024
+
+struct bench_subject {
+  const char *name;
+  void (*setup)(void);
+  void (*teardown)(void);
+  void *(*worker)(void *);
+};
+
+static mpq_ptr queue;
+static arl_ptr list;
+static pthread_mutex_t list_mutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t operations_per_thread;
+
+/*******************************************************************************
+ *    SUBJECTS
+ ******************************************************************************/
+static void mpq_setup(void) { mpq_create(&queue, BENCH_QUEUE_CAPACITY); }
+static void mpq_teardown(void) { mpq_destroy(queue); }
+
+static void *mpq_worker(void *arg) {
+  size_t i;
+  int value;
+
+  (void)arg;
+
+  for (i = 0; i < operations_per_thread; i++) {
+    while (mpq_push(queue, (int)i) != MPQ_SUCCESS)
+      sched_yield();
+    while (mpq_pop(queue, &value) != MPQ_SUCCESS)
+      sched_yield();
+  }
+
+  return NULL;
+}
+
+static void arl_setup(void) { arl_create(&list, BENCH_QUEUE_CAPACITY); }
+static void arl_teardown(void) { arl_destroy(list); }
+
+static void *arl_worker(void *arg) {
+  arl_error err;
+  size_t i;
+  int value;
+
+  (void)arg;
+
+  for (i = 0; i < operations_per_thread; i++) {
+    pthread_mutex_lock(&list_mutex);
+    arl_append(list, (int)i);
+    pthread_mutex_unlock(&list_mutex);
+
+    do {
+      pthread_mutex_lock(&list_mutex);
+      err = arl_pop(list, 0, &value);
+      pthread_mutex_unlock(&list_mutex);
+    } while (err == ARL_ERROR_POP_EMPTY_LIST);
+  }
+
+  return NULL;
+}
+
+static const struct bench_subject subjects[] = {
+    {"mpq_queue", mpq_setup, mpq_teardown, mpq_worker},
+    {"arl_list+mutex", arl_setup, arl_teardown, arl_worker},
+};
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(const struct bench_subject *subject, size_t threads_amount) {
+  pthread_t threads[BENCH_MAX_THREADS];
+  double start, elapsed;
+  size_t i;
+
+  subject->setup();
+
+  start = now_seconds();
+
+  for (i = 0; i < threads_amount; i++) {
+    pthread_create(&threads[i], NULL, subject->worker, NULL);
+  }
+  for (i = 0; i < threads_amount; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  elapsed = now_seconds() - start;
+
+  subject->teardown();
+
+  return elapsed;
+}
+
+int main(int argc, char *argv[]) {
+  size_t max_threads = BENCH_MAX_THREADS, operations = BENCH_DEFAULT_OPERATIONS;
+  size_t threads_amount, k;
+  double elapsed;
+
+  if (argc > 1)
+    max_threads = strtoul(argv[1], NULL, 10);
+  if (argc > 2)
+    operations = strtoul(argv[2], NULL, 10);
+
+  if (max_threads == 0 || max_threads > BENCH_MAX_THREADS)
+    max_threads = BENCH_MAX_THREADS;
+
+  printf("%-16s %8s %12s %12s\n", "subject", "threads", "seconds", "Mops/s");
+
+  for (threads_amount = 1; threads_amount <= max_threads; threads_amount *= 2) {
+    operations_per_thread = operations / threads_amount;
+
+    for (k = 0; k < sizeof(subjects) / sizeof(subjects[0]); k++) {
+      elapsed = run(&subjects[k], threads_amount);
+
+      // Each iteration is one push and one pop.
+      printf("%-16s %8zu %12.4f %12.2f\n", subjects[k].name, threads_amount,
+             elapsed,
+             2.0 * operations_per_thread * threads_amount / elapsed / 1e6);
+    }
+  }
+
+  return 0;
+}
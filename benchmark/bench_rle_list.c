@@ -0,0 +1,162 @@
+/* Memory, scan and random access of run-length encoded list against
+ *  arl_list, both holding the same status codes. Run lengths follow
+ *  geometric distribution, as lengths of repeated codes in logs do.
+ *
+ * Usage: bench_rle_list (<elements>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// App
+#include "arl_list.h"
+#include "rle_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_DEFAULT_ELEMENTS 16000000
+#define BENCH_GETS 4000000
+#define BENCH_CODES 8
+
+/* Average run lengths, from noisy labels to long stable states. */
+static const size_t BENCH_MEAN_RUNS[] = {2, 16, 256, 4096};
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Geometric run length with given mean, at least 1.
+ */
+static size_t random_run_length(size_t mean) {
+  size_t run_length = 1;
+
+  while (run_length < 16 * mean && (size_t)rand() % mean != 0) {
+    run_length++;
+  }
+
+  return run_length;
+}
+
+static void print_result(size_t mean, const char *subject,
+                         const char *operation, double seconds, size_t bytes,
+                         size_t elements) {
+  printf("%6zu %-8s %-10s %12.4f %14zu %10.3f\n", mean, subject, operation,
+         seconds, bytes, (double)bytes / elements);
+}
+
+static int bench_mean(size_t elements, size_t mean) {
+  size_t i, run_i, run_length, k, rle_bytes;
+  long sum_arl = 0, sum_rle = 0;
+  int value, code = 0;
+  double start;
+  arl_ptr arl;
+  rle_ptr rle;
+
+  if (arl_create(&arl, elements) || rle_create(&rle))
+    return 1;
+
+  srand(13);
+  for (i = 0; i < elements; i += run_length) {
+    run_length = random_run_length(mean);
+    if (run_length > elements - i)
+      run_length = elements - i;
+
+    code = (code + 1 + rand() % (BENCH_CODES - 1)) % BENCH_CODES;
+    for (k = 0; k < run_length; k++) {
+      if (arl_append(arl, code))
+        return 1;
+    }
+  }
+
+  start = now_seconds();
+  for (i = 0; i < elements; i++) {
+    arl_get(arl, i, &value);
+    if (rle_append(rle, value))
+      return 1;
+  }
+  rle_bytes = rle_memory_usage(rle);
+  print_result(mean, "rle", "append", now_seconds() - start, rle_bytes,
+               elements);
+
+  start = now_seconds();
+  for (i = 0; i < elements; i++) {
+    arl_get(arl, i, &value);
+    sum_arl += value;
+  }
+  print_result(mean, "arl", "scan", now_seconds() - start,
+               elements * sizeof(int), elements);
+
+  start = now_seconds();
+  for (run_i = 0; run_i < rle_runs_amount(rle); run_i++) {
+    rle_get_run(rle, run_i, &value, &run_length);
+    sum_rle += (long)value * (long)run_length;
+  }
+  print_result(mean, "rle", "scan", now_seconds() - start, rle_bytes,
+               elements);
+
+  if (sum_arl != sum_rle) {
+    fprintf(stderr, "Lists differ!\n");
+    return 1;
+  }
+
+  start = now_seconds();
+  for (i = 0; i < BENCH_GETS; i++) {
+    arl_get(arl, (i * 7919) % elements, &value);
+    sum_arl += value;
+  }
+  print_result(mean, "arl", "get", now_seconds() - start,
+               elements * sizeof(int), elements);
+
+  start = now_seconds();
+  for (i = 0; i < BENCH_GETS; i++) {
+    rle_get(rle, (i * 7919) % elements, &value);
+    sum_rle += value;
+  }
+  print_result(mean, "rle", "get", now_seconds() - start, rle_bytes,
+               elements);
+
+  // Sums keep reads from being optimized out.
+  if (sum_arl == -1 || sum_rle == -1)
+    printf("%ld\n", sum_arl + sum_rle);
+
+  arl_destroy(arl);
+  rle_destroy(rle);
+
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  size_t elements = BENCH_DEFAULT_ELEMENTS, i;
+
+  if (argc > 1)
+    elements = strtoul(argv[1], NULL, 10);
+
+  if (elements == 0)
+    return 1;
+
+  printf("%6s %-8s %-10s %12s %14s %10s\n", "mean", "subject", "operation",
+         "seconds", "bytes", "bytes/elem");
+
+  for (i = 0; i < sizeof(BENCH_MEAN_RUNS) / sizeof(size_t); i++) {
+    if (bench_mean(elements, BENCH_MEAN_RUNS[i]))
+      return 1;
+  }
+
+  return 0;
+}
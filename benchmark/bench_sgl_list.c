@@ -0,0 +1,166 @@
+/* Append throughput of sgl_list against tsl_list and arl_list guarded by
+ *  a mutex.
+ *
+ * Every thread appends `operations / threads` values, so total amount of
+ *  appended values does not depend on threads amount.
+ *
+ * Usage: bench_sgl_list (<max threads>) (<operations>)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// App
+#include "arl_list.h"
+#include "sgl_list.h"
+#include "tsl_list.h"
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define BENCH_MAX_THREADS 64
+#define BENCH_DEFAULT_OPERATIONS 8000000
+#define BENCH_DEFAULT_CAPACITY 1024
+
+struct bench_subject {
+  const char *name;
+  void (*setup)(void);
+  void (*teardown)(void);
+  void *(*worker)(void *);
+};
+
+static sgl_ptr sgl;
+static tsl_ptr tsl;
+static arl_ptr arl;
+static pthread_mutex_t arl_mutex = PTHREAD_MUTEX_INITIALIZER;
+static size_t operations_per_thread;
+
+/*******************************************************************************
+ *    SUBJECTS
+ ******************************************************************************/
+static void sgl_setup(void) { sgl_create(&sgl, BENCH_DEFAULT_CAPACITY); }
+static void sgl_teardown(void) { sgl_destroy(sgl); }
+
+static void *sgl_worker(void *arg) {
+  size_t i;
+
+  (void)arg;
+
+  for (i = 0; i < operations_per_thread; i++) {
+    sgl_append(sgl, (int)i);
+  }
+
+  return NULL;
+}
+
+static void tsl_setup(void) { tsl_create(&tsl, BENCH_DEFAULT_CAPACITY); }
+static void tsl_teardown(void) { tsl_destroy(tsl); }
+
+static void *tsl_worker(void *arg) {
+  size_t i;
+
+  (void)arg;
+
+  for (i = 0; i < operations_per_thread; i++) {
+    tsl_append(tsl, (int)i);
+  }
+
+  return NULL;
+}
+
+static void arl_setup(void) { arl_create(&arl, BENCH_DEFAULT_CAPACITY); }
+static void arl_teardown(void) { arl_destroy(arl); }
+
+static void *arl_worker(void *arg) {
+  size_t i;
+
+  (void)arg;
+
+  for (i = 0; i < operations_per_thread; i++) {
+    pthread_mutex_lock(&arl_mutex);
+    arl_append(arl, (int)i);
+    pthread_mutex_unlock(&arl_mutex);
+  }
+
+  return NULL;
+}
+
+static const struct bench_subject subjects[] = {
+    {"sgl_list", sgl_setup, sgl_teardown, sgl_worker},
+    {"tsl_list", tsl_setup, tsl_teardown, tsl_worker},
+    {"arl_list+mutex", arl_setup, arl_teardown, arl_worker},
+};
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+static double now_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(const struct bench_subject *subject, size_t threads_amount) {
+  pthread_t threads[BENCH_MAX_THREADS];
+  double start, elapsed;
+  size_t i;
+
+  subject->setup();
+
+  start = now_seconds();
+
+  for (i = 0; i < threads_amount; i++) {
+    pthread_create(&threads[i], NULL, subject->worker, NULL);
+  }
+  for (i = 0; i < threads_amount; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  elapsed = now_seconds() - start;
+
+  subject->teardown();
+
+  return elapsed;
+}
+
+int main(int argc, char *argv[]) {
+  size_t max_threads = BENCH_MAX_THREADS, operations = BENCH_DEFAULT_OPERATIONS;
+  size_t threads_amount, k;
+  double elapsed;
+
+  if (argc > 1)
+    max_threads = strtoul(argv[1], NULL, 10);
+  if (argc > 2)
+    operations = strtoul(argv[2], NULL, 10);
+
+  if (max_threads == 0 || max_threads > BENCH_MAX_THREADS)
+    max_threads = BENCH_MAX_THREADS;
+
+  printf("%-16s %8s %12s %12s\n", "subject", "threads", "seconds",
+         "Mappends/s");
+
+  for (threads_amount = 1; threads_amount <= max_threads; threads_amount *= 2) {
+    operations_per_thread = operations / threads_amount;
+
+    for (k = 0; k < sizeof(subjects) / sizeof(subjects[0]); k++) {
+      elapsed = run(&subjects[k], threads_amount);
+
+      printf("%-16s %8zu %12.4f %12.2f\n", subjects[k].name, threads_amount,
+             elapsed, (double)operations_per_thread * threads_amount / elapsed /
+                          1e6);
+    }
+  }
+
+  return 0;
+}
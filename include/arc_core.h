@@ -0,0 +1,65 @@
+/* Type erased array list core. Elements are opaque blocks of bytes, one */
+/*  core is compiled once and shared by typed wrappers (arw_list.h).     */
+
+#ifndef _arc_core_h
+#define _arc_core_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define ARC_SIZE_T_MAX (size_t) - 1
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  ARC_SUCCESS = 0,
+
+  ARC_ERROR_INVALID_ARGS,
+
+  ARC_ERROR_OVERFLOW,
+
+  ARC_ERROR_OUT_OF_MEMORY,
+
+  ARC_ERROR_INDEX_TOO_BIG,
+
+  ARC_ERROR_POP_EMPTY_LIST,
+
+  /* `ARC_ERROR_LEN` stands for number of elements in enum. */
+  ARC_ERROR_LEN,
+} arc_error;
+
+typedef struct arc_def *arc_ptr;
+
+// List operations
+arc_error arc_create(arc_ptr *l, size_t elem_size, size_t default_capacity);
+arc_error arc_create_sized(arc_ptr *l, size_t elem_size, size_t alignment,
+                           size_t default_capacity);
+arc_error arc_destroy(arc_ptr l);
+size_t arc_length(arc_ptr l);
+size_t arc_elem_size(arc_ptr l);
+size_t arc_stride(arc_ptr l);
+const char *arc_strerror(arc_error error);
+
+// List's data operations
+//// Getters
+arc_error arc_at(arc_ptr l, size_t i, void **slot);
+arc_error arc_get(arc_ptr l, size_t i, void *value);
+//// Setters
+arc_error arc_set(arc_ptr l, size_t i, const void *value);
+arc_error arc_emplace(arc_ptr l, size_t i, void **slot);
+arc_error arc_insert(arc_ptr l, size_t i, const void *value);
+arc_error arc_append(arc_ptr l, const void *value);
+arc_error arc_insert_multi(arc_ptr l, size_t i, size_t v_len,
+                           const void *values);
+//// Removers
+arc_error arc_pop(arc_ptr l, size_t i, void *value);
+arc_error arc_clear(arc_ptr l);
+
+#endif
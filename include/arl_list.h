@@ -9,6 +9,9 @@
  ******************************************************************************/
 // C standard library
 #include <stddef.h>
+#ifdef ARL_STATS
+#include <stdio.h>
+#endif
 
 /*******************************************************************************
  *    MACRO
@@ -21,6 +24,15 @@
 
 #define ARL_VALUE_SIZE sizeof(ARL_VALUE_TYPE)
 
+#ifndef ARL_PARALLEL_THREADS_MAX
+#define ARL_PARALLEL_THREADS_MAX 64
+#endif
+
+/* Elements migrated by one insert into incrementally growing list. */
+#ifndef ARL_INCREMENTAL_STEP
+#define ARL_INCREMENTAL_STEP 16
+#endif
+
 /*******************************************************************************
  *    PUBLIC API
  ******************************************************************************/
@@ -48,6 +60,13 @@ typedef enum {
 
   ARL_ERROR_POP_EMPTY_LIST,
 
+  /* Reading or writing list's file failed, `errno` tells why. */
+  ARL_ERROR_IO,
+  ARL_ERROR_INVALID_FORMAT,
+
+  /* List opened by `arl_open_readonly` cannot be modified. */
+  ARL_ERROR_READ_ONLY,
+
   /* Enum assigns values automatically by incrementing
    *   the first value. `ARL_ERROR_LEN` stands for number
    *   of elements in enum (aka `length`).
@@ -57,9 +76,61 @@ typedef enum {
 
 typedef struct arl_def *arl_ptr;
 
+#ifdef ARL_STATS
+/* Operations' statistics, counted with ARL_STATS defined. */
+struct arl_stats {
+  /* Reallocations of the array (growing, shrinking, copying on write) and
+   *  sizes of reallocated arrays in bytes.
+   */
+  size_t reallocs;
+  size_t realloc_bytes;
+  /* Elements moved by inserts and removals not at the list's end. */
+  size_t shifted_right;
+  size_t shifted_left;
+  size_t peak_capacity;
+  /* Places not used by elements, at the moment of reading. */
+  size_t wasted_capacity;
+};
+#endif
+
+#ifdef ARL_ENABLE_MMAP
+/* Access patterns passed to `arl_advise`. */
+enum arl_advice {
+  ARL_ADVICE_NORMAL = 0,
+  ARL_ADVICE_SEQUENTIAL,
+  ARL_ADVICE_RANDOM,
+  ARL_ADVICE_WILLNEED,
+};
+#endif
+
 // List operations
 arl_error arl_create(arl_ptr *l, size_t default_size);
 arl_error arl_destroy(arl_ptr l);
+arl_error arl_clone(arl_ptr l, arl_ptr *clone);
+arl_error arl_serialize(arl_ptr l,
+                        size_t (*write_callback)(const void *data,
+                                                 size_t size, void *arg),
+                        void *arg);
+arl_error arl_deserialize(arl_ptr *l,
+                          size_t (*read_callback)(void *data, size_t size,
+                                                  void *arg),
+                          void *arg);
+#ifdef ARL_ENABLE_MMAP
+arl_error arl_create_mmap(arl_ptr *l, const char *path,
+                          size_t default_capacity);
+arl_error arl_create_reserved(arl_ptr *l, size_t default_capacity,
+                              size_t max_capacity);
+arl_error arl_create_large(arl_ptr *l, size_t default_capacity,
+                           size_t max_capacity);
+arl_error arl_open_readonly(arl_ptr *l, const char *path);
+arl_error arl_sync(arl_ptr l);
+arl_error arl_serialize_fd(arl_ptr l, int fd);
+arl_error arl_deserialize_fd(arl_ptr *l, int fd);
+arl_error arl_advise(arl_ptr l, enum arl_advice advice);
+#endif
+#ifdef ARL_ENABLE_INCREMENTAL
+arl_error arl_create_incremental(arl_ptr *l, size_t default_capacity);
+#endif
 size_t arl_length(arl_ptr l);
 const char *arl_strerror(arl_error error);
 
@@ -72,6 +143,14 @@ arl_error arl_slice(arl_ptr l, size_t start_i, size_t elements_amount,
 arl_error arl_set(arl_ptr l, size_t i, ARL_VALUE_TYPE value);
 arl_error arl_insert(arl_ptr l, size_t i, ARL_VALUE_TYPE value);
 arl_error arl_append(arl_ptr l, ARL_VALUE_TYPE value);
+arl_error arl_set_ptr(arl_ptr l, size_t i,
+                      ARL_VALUE_TYPE const *value);
+arl_error arl_insert_ptr(arl_ptr l, size_t i,
+                         ARL_VALUE_TYPE const *value);
+arl_error arl_append_ptr(arl_ptr l, ARL_VALUE_TYPE const *value);
+arl_error arl_emplace(arl_ptr l, size_t i, ARL_VALUE_TYPE **slot);
+arl_error arl_emplace_back(arl_ptr l, ARL_VALUE_TYPE **slot);
+
 arl_error arl_insert_multi(arl_ptr l, size_t i, size_t v_len,
                            ARL_VALUE_TYPE values[v_len]);
 //// Removers
@@ -80,5 +159,29 @@ arl_error arl_pop_multi(arl_ptr l, size_t i, size_t elements_amount,
                         ARL_VALUE_TYPE holder[]);
 arl_error arl_remove(arl_ptr l, size_t i, void (*callback)(ARL_VALUE_TYPE));
 arl_error arl_clear(arl_ptr l, void (*callback)(ARL_VALUE_TYPE));
+arl_error arl_remove_ptr(arl_ptr l, size_t i,
+                         void (*callback)(ARL_VALUE_TYPE *));
+arl_error arl_clear_ptr(arl_ptr l, void (*callback)(ARL_VALUE_TYPE *));
+arl_error arl_shrink(arl_ptr l);
+
+#ifdef ARL_STATS
+// Statistics
+arl_error arl_stats(arl_ptr l, struct arl_stats *stats);
+void arl_stats_global(struct arl_stats *stats);
+arl_error arl_stats_dump(FILE *file);
+#endif
+
+#ifdef ARL_ENABLE_PARALLEL
+// Parallel operations
+arl_error arl_parallel_set_threads(size_t threads_amount);
+arl_error arl_parallel_sort(arl_ptr l,
+                            int (*compare)(const void *, const void *));
+arl_error arl_parallel_foreach(arl_ptr l,
+                               void (*callback)(ARL_VALUE_TYPE, void *),
+                               void *arg);
+arl_error arl_parallel_map(arl_ptr l,
+                           ARL_VALUE_TYPE (*callback)(ARL_VALUE_TYPE, void *),
+                           void *arg);
+#endif
 
 #endif
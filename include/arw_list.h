@@ -0,0 +1,115 @@
+/* Typed array list wrapper over the type erased core (arc_core.h). Only */
+/*  this header is generated per type, the core is compiled once.       */
+
+/* Functions are static inline shims. Moves and growth happen in the core,
+ * element is copied here with plain assignment, so it's size is known at
+ * compile time and the copy is specialized for the type.
+ * Handle is distinct per generated type, lists of different types can not
+ * be mixed up.
+ * It is a subset of arl_list's API: create, destroy, length, get, set,
+ * insert, append, insert_multi, pop and clear. There is no slice, pop_multi,
+ * remove, callbacks nor storage options, for them generate arl_list.c for
+ * the type.
+ */
+
+#ifndef _arw_list_h
+#define _arw_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "arc_core.h"
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#ifndef ARW_VALUE_TYPE
+#define ARW_VALUE_TYPE void *
+#endif
+
+#define ARW_VALUE_SIZE sizeof(ARW_VALUE_TYPE)
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef struct arw_def *arw_ptr;
+
+// List operations
+static inline arc_error arw_create(arw_ptr *l, size_t default_capacity) {
+  return arc_create((arc_ptr *)l, ARW_VALUE_SIZE, default_capacity);
+}
+
+static inline arc_error arw_destroy(arw_ptr l) {
+  return arc_destroy((arc_ptr)l);
+}
+
+static inline size_t arw_length(arw_ptr l) { return arc_length((arc_ptr)l); }
+
+static inline const char *arw_strerror(arc_error error) {
+  return arc_strerror(error);
+}
+
+// List's data operations
+//// Getters
+static inline arc_error arw_get(arw_ptr l, size_t i, ARW_VALUE_TYPE *value) {
+  void *slot;
+  arc_error err;
+
+  err = arc_at((arc_ptr)l, i, &slot);
+  if (err)
+    return err;
+
+  *value = *(ARW_VALUE_TYPE *)slot;
+
+  return ARC_SUCCESS;
+}
+
+//// Setters
+static inline arc_error arw_set(arw_ptr l, size_t i, ARW_VALUE_TYPE value) {
+  void *slot;
+  arc_error err;
+
+  err = arc_at((arc_ptr)l, i, &slot);
+  if (err)
+    return err;
+
+  *(ARW_VALUE_TYPE *)slot = value;
+
+  return ARC_SUCCESS;
+}
+
+static inline arc_error arw_insert(arw_ptr l, size_t i,
+                                   ARW_VALUE_TYPE value) {
+  void *slot;
+  arc_error err;
+
+  err = arc_emplace((arc_ptr)l, i, &slot);
+  if (err)
+    return err;
+
+  *(ARW_VALUE_TYPE *)slot = value;
+
+  return ARC_SUCCESS;
+}
+
+static inline arc_error arw_append(arw_ptr l, ARW_VALUE_TYPE value) {
+  return arw_insert(l, ARC_SIZE_T_MAX, value);
+}
+
+static inline arc_error arw_insert_multi(arw_ptr l, size_t i, size_t v_len,
+                                         ARW_VALUE_TYPE values[]) {
+  return arc_insert_multi((arc_ptr)l, i, v_len, values);
+}
+
+//// Removers
+static inline arc_error arw_pop(arw_ptr l, size_t i, ARW_VALUE_TYPE *value) {
+  return arc_pop((arc_ptr)l, i, value);
+}
+
+static inline arc_error arw_clear(arw_ptr l) { return arc_clear((arc_ptr)l); }
+
+#endif
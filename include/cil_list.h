@@ -0,0 +1,69 @@
+/* Compressed integer list. Values are kept in blocks of 128, each block is */
+/*  bit-packed with frame of reference or delta encoding.                    */
+
+#ifndef _cil_list_h
+#define _cil_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define CIL_SIZE_T_MAX (size_t) - 1
+
+/* Any integer type up to 64 bits, signed or not. */
+#ifndef CIL_VALUE_TYPE
+#define CIL_VALUE_TYPE int64_t
+#endif
+
+#define CIL_VALUE_SIZE sizeof(CIL_VALUE_TYPE)
+
+/* Number of values in one block. */
+#define CIL_BLOCK_LENGTH 128
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  CIL_SUCCESS = 0,
+
+  CIL_ERROR_INVALID_ARGS,
+
+  CIL_ERROR_OVERFLOW,
+
+  CIL_ERROR_OUT_OF_MEMORY,
+
+  CIL_ERROR_INDEX_TOO_BIG,
+
+  /* `CIL_ERROR_LEN` stands for number of elements in enum. */
+  CIL_ERROR_LEN,
+} cil_error;
+
+typedef struct cil_def *cil_ptr;
+
+// List operations
+cil_error cil_create(cil_ptr *l);
+cil_error cil_destroy(cil_ptr l);
+size_t cil_length(cil_ptr l);
+size_t cil_memory_usage(cil_ptr l);
+const char *cil_strerror(cil_error error);
+
+// List's data operations
+//// Getters
+cil_error cil_get(cil_ptr l, size_t i, CIL_VALUE_TYPE *value);
+size_t cil_blocks_amount(cil_ptr l);
+cil_error cil_decode_block(cil_ptr l, size_t block_i,
+                           CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH],
+                           size_t *values_amount);
+cil_error cil_foreach(cil_ptr l, void (*callback)(CIL_VALUE_TYPE, void *),
+                      void *arg);
+//// Setters
+cil_error cil_append(cil_ptr l, CIL_VALUE_TYPE value);
+cil_error cil_append_multi(cil_ptr l, size_t v_len, CIL_VALUE_TYPE values[]);
+
+#endif
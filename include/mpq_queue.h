@@ -0,0 +1,59 @@
+/* Bounded multi-producer/multi-consumer queue, as described here: */
+/*   https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue */
+
+#ifndef _mpq_queue_h
+#define _mpq_queue_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define MPQ_SIZE_T_MAX (size_t) - 1
+
+#ifndef MPQ_VALUE_TYPE
+#define MPQ_VALUE_TYPE void *
+#endif
+
+#define MPQ_VALUE_SIZE sizeof(MPQ_VALUE_TYPE)
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  MPQ_SUCCESS = 0,
+
+  MPQ_ERROR_INVALID_ARGS,
+
+  MPQ_ERROR_OVERFLOW,
+
+  MPQ_ERROR_OUT_OF_MEMORY,
+
+  /* Full and empty are not failures of the queue itself, they tell
+   *  producer (or consumer) to back off and retry later.
+   */
+  MPQ_ERROR_QUEUE_FULL,
+  MPQ_ERROR_QUEUE_EMPTY,
+
+  /* `MPQ_ERROR_LEN` stands for number of elements in enum. */
+  MPQ_ERROR_LEN,
+} mpq_error;
+
+typedef struct mpq_def *mpq_ptr;
+
+// Queue operations
+mpq_error mpq_create(mpq_ptr *q, size_t capacity);
+mpq_error mpq_destroy(mpq_ptr q);
+size_t mpq_capacity(mpq_ptr q);
+size_t mpq_length(mpq_ptr q);
+const char *mpq_strerror(mpq_error error);
+
+// Queue's data operations
+mpq_error mpq_push(mpq_ptr q, MPQ_VALUE_TYPE value);
+mpq_error mpq_pop(mpq_ptr q, MPQ_VALUE_TYPE *value);
+
+#endif
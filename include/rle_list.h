@@ -0,0 +1,70 @@
+/* Run-length encoded list. Consecutive equal values are stored once, with */
+/*  the number of their repetitions.                                      */
+
+#ifndef _rle_list_h
+#define _rle_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define RLE_SIZE_T_MAX (size_t) - 1
+
+#ifndef RLE_VALUE_TYPE
+#define RLE_VALUE_TYPE int
+#endif
+
+/* Values are merged into runs when equal. Types not comparable with `==`
+ *  (structures) have to define their own comparison.
+ */
+#ifndef RLE_VALUE_EQUAL
+#define RLE_VALUE_EQUAL(a, b) ((a) == (b))
+#endif
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  RLE_SUCCESS = 0,
+
+  RLE_ERROR_INVALID_ARGS,
+
+  RLE_ERROR_OVERFLOW,
+
+  RLE_ERROR_OUT_OF_MEMORY,
+
+  RLE_ERROR_INDEX_TOO_BIG,
+
+  /* `RLE_ERROR_LEN` stands for number of elements in enum. */
+  RLE_ERROR_LEN,
+} rle_error;
+
+typedef struct rle_def *rle_ptr;
+
+// List operations
+rle_error rle_create(rle_ptr *l);
+rle_error rle_destroy(rle_ptr l);
+size_t rle_length(rle_ptr l);
+size_t rle_runs_amount(rle_ptr l);
+size_t rle_memory_usage(rle_ptr l);
+const char *rle_strerror(rle_error error);
+
+// List's data operations
+//// Getters
+rle_error rle_get(rle_ptr l, size_t i, RLE_VALUE_TYPE *value);
+rle_error rle_get_run(rle_ptr l, size_t run_i, RLE_VALUE_TYPE *value,
+                      size_t *run_length);
+rle_error rle_slice(rle_ptr l, size_t start_i, size_t elements_amount,
+                    RLE_VALUE_TYPE slice[]);
+rle_error rle_expand(rle_ptr l, RLE_VALUE_TYPE values[]);
+//// Setters
+rle_error rle_append(rle_ptr l, RLE_VALUE_TYPE value);
+rle_error rle_append_run(rle_ptr l, RLE_VALUE_TYPE value, size_t run_length);
+rle_error rle_insert(rle_ptr l, size_t i, RLE_VALUE_TYPE value);
+
+#endif
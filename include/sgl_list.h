@@ -0,0 +1,63 @@
+/* Concurrent append only segmented list. Storage is a sequence of segments, */
+/*  each twice as big as previous one. Segments are never moved.              */
+
+#ifndef _sgl_list_h
+#define _sgl_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define SGL_SIZE_T_MAX (size_t) - 1
+
+#ifndef SGL_VALUE_TYPE
+#define SGL_VALUE_TYPE void *
+#endif
+
+#define SGL_VALUE_SIZE sizeof(SGL_VALUE_TYPE)
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  SGL_SUCCESS = 0,
+
+  SGL_ERROR_INVALID_ARGS,
+
+  SGL_ERROR_OVERFLOW,
+
+  SGL_ERROR_OUT_OF_MEMORY,
+
+  SGL_ERROR_INDEX_TOO_BIG,
+
+  /* Once segment's allocation failed, list stops accepting new elements.
+   *  Elements appended before stay readable.
+   */
+  SGL_ERROR_LIST_FAILED,
+
+  /* `SGL_ERROR_LEN` stands for number of elements in enum. */
+  SGL_ERROR_LEN,
+} sgl_error;
+
+typedef struct sgl_def *sgl_ptr;
+
+// List operations
+sgl_error sgl_create(sgl_ptr *l, size_t first_segment_capacity);
+sgl_error sgl_destroy(sgl_ptr l);
+size_t sgl_length(sgl_ptr l);
+const char *sgl_strerror(sgl_error error);
+
+// List's data operations
+//// Getters
+sgl_error sgl_get(sgl_ptr l, size_t i, SGL_VALUE_TYPE *value);
+sgl_error sgl_get_ptr(sgl_ptr l, size_t i, SGL_VALUE_TYPE **value);
+//// Setters
+sgl_error sgl_append(sgl_ptr l, SGL_VALUE_TYPE value);
+sgl_error sgl_append_multi(sgl_ptr l, size_t v_len, SGL_VALUE_TYPE values[]);
+
+#endif
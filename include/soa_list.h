@@ -0,0 +1,80 @@
+/* Struct of arrays list. Rows are structures, each field is kept in it's */
+/*  own contiguous array.                                                */
+
+#ifndef _soa_list_h
+#define _soa_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define SOA_SIZE_T_MAX (size_t) - 1
+
+/* Row's fields, `FIELD(type, name)` for each of them. Generator replaces
+ *  it with fields' description, ex. `id:long,score:float` becomes
+ *  `FIELD(long, id) FIELD(float, score)`.
+ */
+#ifndef SOA_FIELDS
+#define SOA_FIELDS(FIELD) FIELD(int, key) FIELD(double, value)
+#endif
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  SOA_SUCCESS = 0,
+
+  SOA_ERROR_INVALID_ARGS,
+
+  SOA_ERROR_OVERFLOW,
+
+  SOA_ERROR_OUT_OF_MEMORY,
+
+  SOA_ERROR_INDEX_TOO_BIG,
+
+  /* `SOA_ERROR_LEN` stands for number of elements in enum. */
+  SOA_ERROR_LEN,
+} soa_error;
+
+#define SOA_ROW_MEMBER(type, name) type name;
+
+/* One row, as passed to and from the list. */
+struct soa_row {
+  SOA_FIELDS(SOA_ROW_MEMBER)
+};
+
+typedef struct soa_def *soa_ptr;
+
+// List operations
+soa_error soa_create(soa_ptr *l, size_t default_capacity);
+soa_error soa_destroy(soa_ptr l);
+size_t soa_length(soa_ptr l);
+const char *soa_strerror(soa_error error);
+
+// List's data operations
+//// Getters
+soa_error soa_get(soa_ptr l, size_t i, struct soa_row *row);
+//// Setters
+soa_error soa_set(soa_ptr l, size_t i, const struct soa_row *row);
+soa_error soa_insert(soa_ptr l, size_t i, const struct soa_row *row);
+soa_error soa_append(soa_ptr l, const struct soa_row *row);
+//// Removers
+soa_error soa_pop(soa_ptr l, size_t i, struct soa_row *row);
+soa_error soa_clear(soa_ptr l);
+
+// Field operations, for each field:
+//  soa_get_<field>, soa_set_<field> access one value,
+//  soa_view_<field> returns field's array, valid until the list grows.
+#define SOA_FIELD_DECLARATIONS(type, name)                                     \
+  soa_error soa_get_##name(soa_ptr l, size_t i, type *value);                  \
+  soa_error soa_set_##name(soa_ptr l, size_t i, type value);                   \
+  const type *soa_view_##name(soa_ptr l);
+
+SOA_FIELDS(SOA_FIELD_DECLARATIONS)
+
+#endif
@@ -0,0 +1,99 @@
+/* Thread safe array list implementation. Array list is described here: */
+/*   https://en.wikipedia.org/wiki/Dynamic_array                        */
+
+#ifndef _tsl_list_h
+#define _tsl_list_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define TSL_SIZE_T_MAX (size_t) - 1
+
+#ifndef TSL_VALUE_TYPE
+#define TSL_VALUE_TYPE void *
+#endif
+
+#define TSL_VALUE_SIZE sizeof(TSL_VALUE_TYPE)
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  TSL_SUCCESS = 0,
+
+  TSL_ERROR_INVALID_ARGS,
+
+  TSL_ERROR_OVERFLOW,
+  TSL_ERROR_UNDERFLOW,
+
+  TSL_ERROR_OUT_OF_MEMORY,
+
+  TSL_ERROR_INDEX_TOO_BIG,
+
+  TSL_ERROR_POP_EMPTY_LIST,
+
+  TSL_ERROR_LOCK,
+
+  TSL_ERROR_SNAPSHOTS_EXHAUSTED,
+
+  /* `TSL_ERROR_LEN` stands for number of elements in enum. */
+  TSL_ERROR_LEN,
+} tsl_error;
+
+typedef struct tsl_def *tsl_ptr;
+
+/* Consistent view of the list. Array is not modified by writers and stays
+ *  valid until the snapshot is released.
+ */
+struct tsl_snapshot {
+  const TSL_VALUE_TYPE *array;
+  size_t length;
+
+  /* Reader's slot, used internally. */
+  size_t slot;
+};
+
+// List operations
+tsl_error tsl_create(tsl_ptr *l, size_t default_capacity);
+tsl_error tsl_destroy(tsl_ptr l);
+size_t tsl_length(tsl_ptr l);
+const char *tsl_strerror(tsl_error error);
+
+// List's data operations
+/* Counts differ from arl_list: arl_slice and arl_pop_multi copy
+ *  `elements_amount + 1` elements (the last index is inclusive), tsl_slice
+ *  and tsl_pop_multi copy exactly `elements_amount` of them. Code ported
+ *  from arl_list has to pass one more.
+ */
+//// Getters
+tsl_error tsl_get(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value);
+tsl_error tsl_get_optimistic(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value);
+tsl_error tsl_slice(tsl_ptr l, size_t start_i, size_t elements_amount,
+                    TSL_VALUE_TYPE slice[]);
+//// Snapshots
+tsl_error tsl_snapshot_acquire(tsl_ptr l, struct tsl_snapshot *snapshot);
+tsl_error tsl_snapshot_release(tsl_ptr l, struct tsl_snapshot *snapshot);
+//// Setters
+tsl_error tsl_set(tsl_ptr l, size_t i, TSL_VALUE_TYPE value);
+tsl_error tsl_insert(tsl_ptr l, size_t i, TSL_VALUE_TYPE value);
+tsl_error tsl_append(tsl_ptr l, TSL_VALUE_TYPE value);
+//// Batch setters, lock is taken once per call
+tsl_error tsl_set_multi(tsl_ptr l, size_t i, size_t v_len,
+                        TSL_VALUE_TYPE values[]);
+tsl_error tsl_insert_multi(tsl_ptr l, size_t i, size_t v_len,
+                           TSL_VALUE_TYPE values[]);
+tsl_error tsl_append_multi(tsl_ptr l, size_t v_len, TSL_VALUE_TYPE values[]);
+//// Removers
+tsl_error tsl_pop(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value);
+tsl_error tsl_pop_multi(tsl_ptr l, size_t i, size_t elements_amount,
+                        TSL_VALUE_TYPE holder[]);
+tsl_error tsl_remove(tsl_ptr l, size_t i, void (*callback)(TSL_VALUE_TYPE));
+tsl_error tsl_clear(tsl_ptr l, void (*callback)(TSL_VALUE_TYPE));
+
+#endif
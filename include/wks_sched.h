@@ -0,0 +1,62 @@
+/* Work stealing task scheduler. Each worker owns Chase-Lev deque, described */
+/*   here: https://www.dre.vanderbilt.edu/~schmidt/PDF/work-stealing-dequeue.pdf */
+
+#ifndef _wks_sched_h
+#define _wks_sched_h
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+/*******************************************************************************
+ *    MACRO
+ ******************************************************************************/
+#define WKS_SIZE_T_MAX (size_t) - 1
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+typedef enum {
+  WKS_SUCCESS = 0,
+
+  WKS_ERROR_INVALID_ARGS,
+
+  WKS_ERROR_OVERFLOW,
+
+  WKS_ERROR_OUT_OF_MEMORY,
+
+  WKS_ERROR_THREAD,
+
+  /* `WKS_ERROR_LEN` stands for number of elements in enum. */
+  WKS_ERROR_LEN,
+} wks_error;
+
+typedef struct wks_def *wks_ptr;
+
+/* Tasks spawned into the group are joined by `wks_wait`. Group can live on
+ *  the stack, it has to be initialized by `wks_group_init`.
+ */
+struct wks_group {
+  size_t pending;
+};
+
+// Scheduler operations
+wks_error wks_create(wks_ptr *s, size_t workers_amount);
+wks_error wks_destroy(wks_ptr s);
+size_t wks_workers_amount(wks_ptr s);
+const char *wks_strerror(wks_error error);
+
+// Fork/join
+void wks_group_init(struct wks_group *group);
+wks_error wks_spawn(wks_ptr s, struct wks_group *group,
+                    void (*function)(void *), void *arg);
+wks_error wks_wait(wks_ptr s, struct wks_group *group);
+
+// Loops
+wks_error wks_parallel_for(wks_ptr s, size_t start, size_t end, size_t grain,
+                           void (*body)(size_t start, size_t end, void *arg),
+                           void *arg);
+
+#endif
@@ -0,0 +1,124 @@
+#!/bin/env python3
+import argparse
+import json
+import os
+import sys
+
+# Compares benchmarks' JSON results (see benchmark/bench_harness.h) with
+#  baseline ones. Results are matched by benchmark, type, operation and
+#  size. Exits with 1 if any of them got slower than the threshold allows.
+#  Instead of the time, hardware counter per operation can be compared
+#  (ex. instructions), results without it are skipped.
+
+COUNTERS = [
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "dtlb_misses",
+    "branch_misses",
+]
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare benchmark results against a baseline."
+    )
+    parser.add_argument("baseline", help="JSON file or directory of them")
+    parser.add_argument("current", help="JSON file or directory of them")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.10,
+        help="allowed slowdown, 0.10 means 10%% (default)",
+    )
+    parser.add_argument(
+        "--metric",
+        choices=["ns_per_op"] + COUNTERS,
+        default="ns_per_op",
+        help="compared value, counters are compared per operation",
+    )
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline, args.metric)
+    current = load_results(args.current, args.metric)
+
+    regressions = 0
+    print(
+        "{:<10} {:<22} {:<14} {:>10} {:>14} {:>14} {:>8}".format(
+            "benchmark", "type", "operation", "size", "base", "current", "change"
+        )
+    )
+
+    for key in sorted(current, key=str):
+        if key not in baseline:
+            continue
+
+        base_value, value = baseline[key], current[key]
+        # Operations not run for the size (ex. slice of 10 elements).
+        if base_value <= 0:
+            continue
+
+        change = value / base_value - 1
+        is_regression = change > args.threshold
+        regressions += is_regression
+
+        print(
+            "{:<10} {:<22} {:<14} {:>10} {:>14.3f} {:>14.3f} {:>+7.1f}%{}".format(
+                *key, base_value, value, change * 100, "  REGRESSION" if is_regression else ""
+            )
+        )
+
+    missing = sorted(set(baseline) - set(current), key=str)
+    for key in missing:
+        print("Missing in current results:", *key)
+
+    if regressions:
+        print("{} regression(s) over {:.0%}".format(regressions, args.threshold))
+        sys.exit(1)
+
+
+def load_results(path: str, metric: str) -> dict:
+    paths = [path]
+    if os.path.isdir(path):
+        paths = [
+            os.path.join(path, name)
+            for name in sorted(os.listdir(path))
+            if name.endswith(".json")
+        ]
+
+    results = {}
+    for file_path in paths:
+        with open(file_path, "r") as fp:
+            report = json.load(fp)
+
+        # Reports of other formats (ex. bench_arl_latency's percentiles) may
+        #  share the directory, they are not comparable.
+        if "type" not in report or any(
+            "ns_per_op" not in result for result in report.get("results", [])
+        ):
+            continue
+
+        for result in report["results"]:
+            if metric == "ns_per_op":
+                value = result["ns_per_op"]
+            else:
+                # Not available when measured, or older results.
+                count = result.get("counters", {}).get(metric)
+                if count is None or not result["ops"]:
+                    continue
+                value = count / result["ops"]
+
+            key = (
+                report["benchmark"],
+                report["type"],
+                result["operation"],
+                result["size"],
+            )
+            results[key] = value
+
+    return results
+
+
+if __name__ == "__main__":
+    main()
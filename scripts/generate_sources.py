@@ -8,18 +8,22 @@ if len(sys.argv) < 4:
     raise ValueError(
         """Not enough arguments!
 Syntax: python3 generate_sources.py <source file> <new prefix> <new type> (<dest dir>)
+Struct of arrays lists take fields instead of type: <name>:<type>,<name>:<type>
+Typed wrappers (include/arw_list.h) generate header only, core is shared.
 """
     )
 
 
-DEFAULT_TYPE = "ARL_VALUE_TYPE"
-DEFAULT_PREFIX = "arl_"
-# TO-DO get DEFAULT_PREFIX and DEFAULT_TYPE dyanmically, based on file_path
-
 file_path = sys.argv[1]
 new_prefix = sys.argv[2] + "_"
 new_type = sys.argv[3]
 
+# Each list's public interface is prefixed by the first part of it's file
+#  name, ex. `arl_list.c` uses `arl_` and `ARL_VALUE_TYPE`.
+DEFAULT_PREFIX = Path(file_path).stem.split("_")[0] + "_"
+DEFAULT_TYPE = DEFAULT_PREFIX.upper() + "VALUE_TYPE"
+DEFAULT_FIELDS = DEFAULT_PREFIX.upper() + "FIELDS"
+
 
 _THIS_DIR = os.path.dirname(os.path.abspath(__file__))
 _SRC_DIR = os.path.join(_THIS_DIR, "..", "src")
@@ -33,6 +37,9 @@ def main():
     ]
 
     for file_ in files_to_gen:
+        # Typed wrappers over shared core have no source, only header.
+        if not os.path.exists(file_):
+            continue
         regenerate_file(file_)
 
 
@@ -56,7 +63,9 @@ def regenerate_file(file_path: str) -> None:
 
 def regenerate_content(file_content: str) -> str:
     regeneration_functions = [
+        define_fields,
         sanitize_content,
+        define_type_tag,
         lambda string: string.replace(DEFAULT_TYPE, new_type),
         lambda string: string.replace(
             DEFAULT_PREFIX.lower(), new_prefix.lower()
@@ -71,9 +80,45 @@ def regenerate_content(file_content: str) -> str:
 
 def sanitize_content(file_content: str) -> str:
     # definitons need to be deleted, they break compilation
-    regex = r"#ifndef ARL_VALUE_TYPE(\n^(?!#endif$).*)+\n#endif"
+    regex = r"#ifndef " + DEFAULT_TYPE + r"(\n^(?!#endif$).*)+\n#endif"
     return re.sub(regex, "\n", file_content, flags=re.M)
 
 
+def define_fields(file_content: str) -> str:
+    # Fields' description replaces default fields of struct of arrays list,
+    #  ex. `id:long,score:float` -> `FIELD(long, id) FIELD(float, score)`.
+    if ":" not in new_type:
+        return file_content
+
+    fields = []
+    for field in new_type.split(","):
+        name, _, type_ = field.partition(":")
+        if not name.strip() or not type_.strip():
+            raise ValueError("Invalid field description: " + field)
+        fields.append("FIELD({}, {})".format(" ".join(type_.split()), name.strip()))
+
+    definition = "#define {}(FIELD) {}".format(DEFAULT_FIELDS, " ".join(fields))
+    regex = r"#ifndef " + DEFAULT_FIELDS + r"(\n^(?!#endif$).*)+\n#endif"
+    return re.sub(regex, lambda _: definition, file_content, flags=re.M)
+
+
+def define_type_tag(file_content: str) -> str:
+    # Lists writing files identify element's type by FNV-1a hash of it's
+    #  spelling, generated sources get it precomputed. Spelling is
+    #  normalized the way C preprocessor stringifies it.
+    type_tag_macro = DEFAULT_PREFIX.upper() + "TYPE_TAG"
+    if type_tag_macro not in file_content or "#include" not in file_content:
+        return file_content
+
+    type_tag = 14695981039346656037
+    for byte in " ".join(new_type.split()).encode():
+        type_tag = ((type_tag ^ byte) * 1099511628211) % 2**64
+
+    definition = "#define {} {:#x}u\n".format(type_tag_macro, type_tag)
+    first_include = file_content.index("#include")
+
+    return file_content[:first_include] + definition + file_content[first_include:]
+
+
 if __name__ == "__main__":
     main()
@@ -0,0 +1,116 @@
+#!/bin/bash
+
+# Counts instructions (Ir) and simulated cache misses of arl_list's
+#  operations with callgrind (benchmark/bench_arl_callgrind.c) and compares
+#  them with benchmark/callgrind_baseline.txt. Fails if any count grew over
+#  the threshold. Counts depend on compiler and flags, baseline has to be
+#  updated (--update) on the same toolchain which checks it.
+#
+# Baseline may be elsewhere (CALLGRIND_BASELINE), ex. counted on target
+#  branch by CI.
+#
+# Thresholds in percents: IR_THRESHOLD (default 2), MISSES_THRESHOLD
+#  (default 10). Misses are allowed to grow by MISSES_SLACK (default 64)
+#  anyway, so tiny counts do not fail.
+
+builddir="$1"
+update="$2"
+
+if [ -z "$1" ] || [ "$1" == "--update" ]
+then
+    update="$1"
+    builddir="build"
+fi
+
+baseline="${CALLGRIND_BASELINE:-$(dirname "$0")/../benchmark/callgrind_baseline.txt}"
+bench="$builddir/benchmark/bench_arl_callgrind"
+ir_threshold="${IR_THRESHOLD:-2}"
+misses_threshold="${MISSES_THRESHOLD:-10}"
+misses_slack="${MISSES_SLACK:-64}"
+
+if [ ! -x "$bench" ]
+then
+    echo "$bench not found, setup build with -Denable_benchmarks=true"
+    exit 1
+fi
+
+outdir=$(mktemp -d)
+trap 'rm -rf "$outdir"' EXIT
+
+# Prints "<operation> <Ir> <D1 misses> <LL misses>" for each operation.
+count_operations() {
+    for operation in $("$bench" --list)
+    do
+        out="$outdir/$operation.out"
+
+        valgrind --tool=callgrind --cache-sim=yes --collect-atstart=no \
+                 --toggle-collect="op_$operation" --callgrind-out-file="$out" \
+                 "$bench" "$operation" 2> "$outdir/$operation.log" || \
+            { cat "$outdir/$operation.log" >&2; return 1; }
+
+        # Summary line holds events in order of events line.
+        awk -v operation="$operation" '
+            /^events:/ { for (i = 2; i <= NF; i++) events[i - 1] = $i }
+            /^summary:/ { for (i = 2; i <= NF; i++) count[events[i - 1]] = $i }
+            END {
+                printf "%s %d %d %d\n", operation, count["Ir"],
+                    count["D1mr"] + count["D1mw"], count["DLmr"] + count["DLmw"]
+            }' "$out"
+    done
+}
+
+current="$outdir/current.txt"
+count_operations > "$current" || exit 1
+
+if [ "$update" == "--update" ]
+then
+    {
+        echo "# operation Ir D1_misses LL_misses"
+        cat "$current"
+    } > "$baseline"
+    cat "$baseline"
+    exit 0
+fi
+
+if [ ! -f "$baseline" ]
+then
+    echo "$baseline not found, create it with --update"
+    exit 1
+fi
+
+awk -v ir_threshold="$ir_threshold" -v misses_threshold="$misses_threshold" \
+    -v misses_slack="$misses_slack" '
+    function check(name, base, value, threshold, slack) {
+        if (value > base * (1 + threshold / 100) && value - base > slack) {
+            regression = " REGRESSION"
+            return 1
+        }
+        return 0
+    }
+
+    NR == FNR {
+        if ($1 !~ /^#/)
+            base[$1] = $0
+        next
+    }
+
+    {
+        if (!($1 in base)) {
+            print "Missing in baseline: " $1
+            next
+        }
+        split(base[$1], b, " ")
+        regression = ""
+        regressions += check("Ir", b[2], $2, ir_threshold, 0)
+        regressions += check("D1", b[3], $3, misses_threshold, misses_slack)
+        regressions += check("LL", b[4], $4, misses_threshold, misses_slack)
+        printf "%-14s Ir %12d -> %12d   D1 %8d -> %8d   LL %8d -> %8d%s\n",
+            $1, b[2], $2, b[3], $3, b[4], $4, regression
+    }
+
+    END {
+        if (regressions) {
+            print regressions " regression(s)"
+            exit 1
+        }
+    }' "$baseline" "$current"
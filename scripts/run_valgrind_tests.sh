@@ -8,7 +8,8 @@ then
     builddir="build"
 fi
 
-meson test --wrap='valgrind --leak-check=full --show-leak-kinds=all --error-exitcode=1 -s' $test_name -C $builddir && \
+# ThreadSanitizer binaries cannot run under valgrind.
+meson test --no-suite tsan --wrap='valgrind --leak-check=full --show-leak-kinds=all --error-exitcode=1 -s' $test_name -C $builddir && \
 
 success=$?
 
@@ -0,0 +1,376 @@
+/* Type erased array list core. Elements are opaque blocks of bytes, one */
+/*  core is compiled once and shared by typed wrappers (arw_list.h).     */
+
+/* Every type generated from arl_list.c carries it's own copy of the whole
+ * list. With many element types that is mostly the same machine code, only
+ * element's size differs. This core keeps:
+ * - Growth, moves and bounds checks, parametrized by element's size stored
+ *     in the instance. They are not type dependent, so they are compiled
+ *     once.
+ * - Slots (pointers to elements) returned by arc_at and arc_emplace, so
+ *     the element itself can be copied by the caller. Typed wrappers copy
+ *     with plain assignment of known size, which compiler specializes.
+ * - Elements placed every `stride` bytes, element's size rounded up to
+ *     it's alignment. Records known only at runtime (arc_create_sized) are
+ *     stored inline, without allocation per element.
+ * Moves are memmove of `length * stride` bytes with stride read at runtime,
+ *  they are not specialized per type the way arl_list's are. Only what
+ *  typed wrappers need is here, not whole arl_list's API.
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "arc_core.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+struct arc_def {
+  /* Elements' bytes, `stride` per element. Aligned inside `allocation`. */
+  char *array;
+  char *allocation;
+
+  /* Size of one element in bytes. */
+  size_t elem_size;
+
+  /* Distance between elements, size rounded up to alignment. */
+  size_t stride;
+  size_t alignment;
+
+  /* Number of elements.*/
+  size_t length;
+
+  /* Number of elements array has place for. */
+  size_t capacity;
+};
+
+static char *_slot(arc_ptr l, size_t i);
+static char *_align(char *p, size_t alignment);
+static arc_error _reserve(arc_ptr l, size_t length);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const ARC_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Index too big",
+    // 5
+    "Pop on empty list",
+};
+
+static const size_t ARC_ERROR_STRINGS_LEN =
+    sizeof(ARC_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates list's instance for elements of `elem_size` bytes, aligned the
+ *  way malloc aligns.
+ */
+arc_error arc_create(arc_ptr *l, size_t elem_size, size_t default_capacity) {
+  return arc_create_sized(l, elem_size, 1, default_capacity);
+}
+
+/* Creates list's instance for elements of `elem_size` bytes, each of them
+ *  aligned to `alignment` (power of two). Size and alignment can come from
+ *  runtime, ex. from records' schema.
+ */
+arc_error arc_create_sized(arc_ptr *l, size_t elem_size, size_t alignment,
+                           size_t default_capacity) {
+  arc_ptr l_local;
+  arc_error err;
+
+  if (elem_size == 0 || alignment == 0 || (alignment & (alignment - 1)))
+    return ARC_ERROR_INVALID_ARGS;
+
+  if (_is_overflow_size_t_add(elem_size, alignment - 1))
+    return ARC_ERROR_OVERFLOW;
+
+  l_local = malloc(sizeof(struct arc_def));
+  if (!l_local)
+    return ARC_ERROR_OUT_OF_MEMORY;
+
+  l_local->array = NULL;
+  l_local->allocation = NULL;
+  l_local->elem_size = elem_size;
+  l_local->stride = (elem_size + alignment - 1) & ~(alignment - 1);
+  l_local->alignment = alignment;
+  l_local->length = 0;
+  l_local->capacity = 0;
+
+  err = _reserve(l_local, default_capacity);
+  if (err)
+    goto CLEANUP_L_LOCAL;
+
+  *l = l_local;
+
+  return ARC_SUCCESS;
+
+CLEANUP_L_LOCAL:
+  free(l_local);
+  return err;
+}
+
+/* Frees resouces allocated for list's instance.
+ */
+arc_error arc_destroy(arc_ptr l) {
+  free(l->allocation);
+  free(l);
+
+  return ARC_SUCCESS;
+}
+
+/* Returns list's length.
+ * Does not return error, to be usable in for loop (see arl_length).
+ */
+size_t arc_length(arc_ptr l) { return l->length; }
+
+/* Returns size of one element in bytes.
+ */
+size_t arc_elem_size(arc_ptr l) { return l->elem_size; }
+
+/* Returns distance between elements in bytes.
+ */
+size_t arc_stride(arc_ptr l) { return l->stride; }
+
+/* Sets slot to the element under the index. Slot is valid until the next
+ *  list's modification.
+ */
+arc_error arc_at(arc_ptr l, size_t i, void **slot) {
+  if (i >= l->length)
+    return ARC_ERROR_INDEX_TOO_BIG;
+
+  *slot = _slot(l, i);
+
+  return ARC_SUCCESS;
+}
+
+/* Copies element under the index into value.
+ */
+arc_error arc_get(arc_ptr l, size_t i, void *value) {
+  if (i >= l->length)
+    return ARC_ERROR_INDEX_TOO_BIG;
+
+  memcpy(value, _slot(l, i), l->elem_size);
+
+  return ARC_SUCCESS;
+}
+
+/* Copies value into element under the index.
+ */
+arc_error arc_set(arc_ptr l, size_t i, const void *value) {
+  if (i >= l->length)
+    return ARC_ERROR_INDEX_TOO_BIG;
+
+  memcpy(_slot(l, i), value, l->elem_size);
+
+  return ARC_SUCCESS;
+}
+
+/* Makes place for one element under the index, and sets slot to it.
+ *  Element is left uninitialized. Slot is valid until the next list's
+ *  modification.
+ * If index bigger than list's length, place is made at the end.
+ */
+arc_error arc_emplace(arc_ptr l, size_t i, void **slot) {
+  arc_error err;
+
+  if (_is_overflow_size_t_add(l->length, 1))
+    return ARC_ERROR_OVERFLOW;
+
+  err = _reserve(l, l->length + 1);
+  if (err)
+    return err;
+
+  if (i > l->length)
+    i = l->length;
+
+  memmove(_slot(l, i + 1), _slot(l, i), (l->length - i) * l->stride);
+  l->length++;
+
+  *slot = _slot(l, i);
+
+  return ARC_SUCCESS;
+}
+
+/* Insert one element under the index.
+ * If index bigger than list's length, appends the value.
+ * Value can not point into the list, list may be moved before the copy.
+ */
+arc_error arc_insert(arc_ptr l, size_t i, const void *value) {
+  void *slot;
+  arc_error err;
+
+  err = arc_emplace(l, i, &slot);
+  if (err)
+    return err;
+
+  memcpy(slot, value, l->elem_size);
+
+  return ARC_SUCCESS;
+}
+
+/* Appends one element to the list's end.
+ */
+arc_error arc_append(arc_ptr l, const void *value) {
+  return arc_insert(l, l->length, value);
+}
+
+/* Insert multiple elements, moving elements only once.
+ * Values is array of `v_len` elements, placed every arc_stride bytes.
+ */
+arc_error arc_insert_multi(arc_ptr l, size_t i, size_t v_len,
+                           const void *values) {
+  arc_error err;
+
+  if (v_len == 0)
+    return ARC_SUCCESS;
+
+  if (_is_overflow_size_t_add(l->length, v_len))
+    return ARC_ERROR_OVERFLOW;
+
+  err = _reserve(l, l->length + v_len);
+  if (err)
+    return err;
+
+  if (i > l->length)
+    i = l->length;
+
+  memmove(_slot(l, i + v_len), _slot(l, i), (l->length - i) * l->stride);
+  memcpy(_slot(l, i), values, v_len * l->stride);
+  l->length += v_len;
+
+  return ARC_SUCCESS;
+}
+
+/* Pops element from under the index, and copies it into value if value is
+ *  not NULL.
+ * If i bigger than list's length, pops the last element.
+ */
+arc_error arc_pop(arc_ptr l, size_t i, void *value) {
+  if (l->length == 0)
+    return ARC_ERROR_POP_EMPTY_LIST;
+
+  if (i >= l->length)
+    i = l->length - 1;
+
+  if (value)
+    memcpy(value, _slot(l, i), l->elem_size);
+
+  memmove(_slot(l, i), _slot(l, i + 1), (l->length - i - 1) * l->stride);
+  l->length--;
+
+  return ARC_SUCCESS;
+}
+
+/* Removes all elements, capacity is kept.
+ */
+arc_error arc_clear(arc_ptr l) {
+  l->length = 0;
+
+  return ARC_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *arc_strerror(arc_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= ARC_ERROR_LEN) || (error >= ARC_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return ARC_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+char *_slot(arc_ptr l, size_t i) { return l->array + i * l->stride; }
+
+char *_align(char *p, size_t alignment) {
+  return p + ((alignment - (uintptr_t)p % alignment) % alignment);
+}
+
+/* Makes sure array has place for `length` elements. Grows the same way as
+ *  arl_list, by half of the length plus current capacity.
+ * Allocation has `alignment - 1` spare bytes, so aligned array fits in it.
+ *  Realloc keeps bytes, not alignment, elements are moved if array's
+ *  offset in the new allocation differs.
+ */
+arc_error _reserve(arc_ptr l, size_t length) {
+  size_t new_capacity, offset;
+  char *p, *array;
+
+  if (length <= l->capacity)
+    return ARC_SUCCESS;
+
+  if (_is_overflow_size_t_multi(l->length, 3) ||
+      _is_overflow_size_t_add(3 * l->length / 2, l->capacity))
+    return ARC_ERROR_OVERFLOW;
+
+  new_capacity = 3 * l->length / 2 + l->capacity;
+  if (new_capacity < length)
+    new_capacity = length;
+
+  if (_is_overflow_size_t_multi(new_capacity, l->stride) ||
+      _is_overflow_size_t_add(new_capacity * l->stride, l->alignment - 1))
+    return ARC_ERROR_OVERFLOW;
+
+  offset = l->allocation ? (size_t)(l->array - l->allocation) : 0;
+
+  p = realloc(l->allocation, new_capacity * l->stride + l->alignment - 1);
+  if (!p)
+    return ARC_ERROR_OUT_OF_MEMORY;
+
+  array = _align(p, l->alignment);
+  if (array != p + offset)
+    memmove(array, p + offset, l->length * l->stride);
+
+  l->allocation = p;
+  l->array = array;
+  l->capacity = new_capacity;
+
+  return ARC_SUCCESS;
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, ARC_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, ARC_SIZE_T_MAX);
+}
@@ -8,6 +8,7 @@
  * usefull for someone, it is not essential to list's logic (in opposition
  * to growing). I would rather do some versions of current functions which
  * would shrink internall array, than edit current ones. Maybe even new list?
+ * For now `arl_shrink` frees unused memory on demand.
  */
 
 /* Notes:
@@ -28,6 +29,77 @@
  *
  */
 
+/* Clones share the array under a reference count, so cloning costs two small
+ * allocations no matter list's length. First mutation of a shared list
+ * copies the array (copy on write), other lists sharing it stay untouched.
+ * Reference count is updated atomically, so clones may be handed to other
+ * threads. Single list is still not thread safe.
+ */
+
+/* With ARL_ENABLE_PARALLEL defined, list gets parallel sort, foreach and map.
+ * Work is done by a pool of pthreads owned by the library, started on the first
+ * parallel call and joined at exit. Array is split into ranges whose boundaries
+ * lie on cache lines' boundaries, so threads writing neighbouring ranges do not
+ * share lines. Sorting sorts ranges with qsort and merges sorted runs in
+ * passes; every pass splits the output evenly between threads (merge path), so
+ * last passes are as parallel as the first ones. Pool is arl_list's own rather
+ * than wks_sched's, so the list still takes just it's two files. Ranges are
+ * even and known upfront, which needs no work stealing.
+ */
+
+/* With ARL_ENABLE_MMAP defined (POSIX only), list's array may live outside
+ * of the heap. Storage kind is kept in the list and functions allocating,
+ * growing and freeing the array dispatch on it:
+ * - file: array follows a header in a file mapped with MAP_SHARED
+ *     (`arl_create_mmap`). Growing extends the file and the mapping (mremap
+ *     where available), so reopening the file gives the list back.
+ * - reserved: address range for maximum capacity is reserved up front with
+ *     PROT_NONE (`arl_create_reserved`), growing only makes more of its pages
+ *     accessible. Elements are never copied and their addresses stay the
+ *     same for list's lifetime. Memory is used by touched pages only.
+ * - large: reserved storage aligned to 2MB, with transparent huge pages
+ *     requested (`arl_create_large`), so random access to very big lists
+ *     misses TLB less often.
+ * - read only: serialized list's file mapped with PROT_READ
+ *     (`arl_open_readonly`). Opening costs no parsing nor copying, pages are
+ *     read in on the first access and shared with other processes mapping
+ *     the file. All modifying functions return ARL_ERROR_READ_ONLY.
+ * Pages of reserved and large storage which are not used by any element are
+ * given back to the system by `arl_clear` and `arl_shrink`, address range
+ * stays reserved.
+ * File header is described in `struct arl_file_header`, it identifies
+ * element's type by hash of ARL_VALUE_TYPE's spelling, so file written by
+ * list of other type is rejected. `arl_serialize` writes the same format
+ * (available without ARL_ENABLE_MMAP), so serialized list can be mapped.
+ */
+
+/* With ARL_ENABLE_INCREMENTAL defined, heap list may grow incrementally
+ * (`arl_create_incremental`), like hash tables rehashing incrementally.
+ * Growing allocates new array without copying, elements stay in the old one
+ * and are migrated ARL_INCREMENTAL_STEP at a time by following inserts.
+ * Elements [migrated, migration_end) are read from the old array until
+ * then. Growth factor leaves more free places than elements to migrate, so
+ * migration ends before the next growth and single append never copies
+ * the whole array. Operations shifting elements or needing the array in
+ * one piece (slots, serialization, parallel functions, cloning, shrinking)
+ * finish the migration first.
+ */
+
+/* With ARL_STATS defined, every list counts reallocations, shifted elements
+ * and peak capacity (see `struct arl_stats`). Live lists are linked in a
+ * registry guarded by a spin lock, taken only on creating and destroying
+ * lists and by `arl_stats_dump`. Counters of destroyed lists are added to
+ * the global ones. Dump reads counters of lists which may be modified by
+ * other threads meanwhile, so it is a best effort snapshot.
+ */
+
+/* With ARL_ENABLE_USDT defined, list has static tracepoints (sys/sdt.h) of
+ * `arl_list` provider: create, destroy, clear, grow_start, grow_done,
+ * grow_failed, shift_right and shift_left. Not attached probe is a single
+ * nop, arguments are already in registers. bpftrace scripts using them are
+ * in scripts/bpftrace.
+ */
+
 // TO-DO extend - join two lists into one
 // TO-DO shrink array:
 // 1. pop
@@ -37,6 +109,19 @@
 //     ?? do we really need it? I think this is duplication of
 //     destroy currtent list, create a new one. ??
 
+#if defined(ARL_ENABLE_MMAP) && defined(__linux__)
+// mremap
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#endif
+
+#if defined(ARL_ENABLE_PARALLEL) || defined(ARL_ENABLE_MMAP)
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+#endif
+
 /*******************************************************************************
  *    IMPORTS
  ******************************************************************************/
@@ -45,8 +130,23 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef ARL_ENABLE_PARALLEL
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#ifdef ARL_ENABLE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#ifdef ARL_ENABLE_USDT
+#include <sys/sdt.h>
+#endif
 
 // App
 #include "arl_list.h"
@@ -57,6 +157,72 @@
 /*******************************************************************************
  *    PRIVATE DECLARATIONS
  ******************************************************************************/
+// Probes are named `arl_list:<name>`, generated lists get their own prefix.
+#ifdef ARL_ENABLE_USDT
+#define _ARL_PROBE1(name, a) DTRACE_PROBE1(arl_list, name, a)
+#define _ARL_PROBE2(name, a, b) DTRACE_PROBE2(arl_list, name, a, b)
+#define _ARL_PROBE3(name, a, b, c) DTRACE_PROBE3(arl_list, name, a, b, c)
+#else
+#define _ARL_PROBE1(name, a) ((void)0)
+#define _ARL_PROBE2(name, a, b) ((void)0)
+#define _ARL_PROBE3(name, a, b, c) ((void)0)
+#endif
+
+#define _ARL_STRINGIFY(x) #x
+#define _ARL_TO_STRING(x) _ARL_STRINGIFY(x)
+
+#define ARL_FILE_MAGIC "ARLLIST"
+#define ARL_FILE_VERSION 1
+/* Serialized array is passed to the callbacks in blocks of this size, it has
+ *  to be a multiple of 8 (see `_checksum_update`).
+ */
+#define ARL_FILE_BLOCK_SIZE (1024 * 1024)
+#define ARL_CHECKSUM_BASIS 14695981039346656037u
+#define ARL_CHECKSUM_PRIME 1099511628211u
+/* Written in native byte order, reads differently on other endianness. */
+#define ARL_FILE_ENDIANNESS 0x01020304
+
+/* Header of files holding lists, 64 bytes so array following it keeps
+ *  cache line's alignment.
+ */
+struct arl_file_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t endianness;
+  uint64_t value_size;
+  /* Hash of ARL_VALUE_TYPE's spelling. */
+  uint64_t type_tag;
+  uint64_t length;
+  /* Number of elements which fit in the file. */
+  uint64_t capacity;
+  /* 0 stands for not computed checksum. */
+  uint64_t checksum;
+  uint64_t _reserved;
+};
+
+enum arl_storage {
+  ARL_STORAGE_HEAP = 0,
+  ARL_STORAGE_FILE,
+  ARL_STORAGE_RESERVED,
+  ARL_STORAGE_LARGE,
+  ARL_STORAGE_READONLY,
+};
+
+#ifdef ARL_ENABLE_MMAP
+/* Size of huge page on x86-64 and most of arm64 setups. */
+#define ARL_LARGE_PAGE_SIZE (2 * 1024 * 1024)
+
+struct arl_mapping {
+  void *address;
+  /* Whole mapping, for reserved storage accessible part is smaller. */
+  size_t size;
+  /* Mapping is commited in multiples of it. */
+  size_t page_size;
+  /* -1 for anonymous mappings. */
+  int fd;
+};
+#endif
+
 struct arl_def {
   /* Number of elements.*/
   size_t length;
@@ -66,12 +232,99 @@ struct arl_def {
 
   /* Storage. */
   ARL_VALUE_TYPE *array;
+
+  /* Number of lists sharing the storage, NULL if storage is not shared. */
+  size_t *refs;
+
+  /* Where the array lives, see notes. */
+  enum arl_storage storage;
+#ifdef ARL_ENABLE_MMAP
+  struct arl_mapping mapping;
+  /* Capacity reserved storage never grows over, mapping may be bigger. */
+  size_t max_capacity;
+#endif
+#ifdef ARL_ENABLE_INCREMENTAL
+  /* Grows incrementally, see notes. */
+  bool incremental;
+  /* Array before the last growth, NULL when migration is done. */
+  ARL_VALUE_TYPE *old_array;
+  /* Elements [migrated, migration_end) are still in `old_array`. */
+  size_t migrated;
+  size_t migration_end;
+#endif
+#ifdef ARL_STATS
+  struct arl_stats stats;
+  /* Neighbours in the registry of live lists. */
+  arl_ptr stats_prev;
+  arl_ptr stats_next;
+#endif
+};
+
+#ifdef ARL_STATS
+/* Live lists and counters of destroyed ones. */
+struct arl_stats_registry {
+  bool lock;
+  arl_ptr lists;
+  struct arl_stats destroyed;
 };
 
+static struct arl_stats_registry _stats_registry;
+#endif
+
 static bool _is_i_too_big(arl_ptr l, size_t i);
 static void _get(arl_ptr l, size_t i, ARL_VALUE_TYPE *value);
-static void _set(arl_ptr l, size_t i, ARL_VALUE_TYPE value);
+static void _set(arl_ptr l, size_t i, ARL_VALUE_TYPE const *value);
+static ARL_VALUE_TYPE *_slot(arl_ptr l, size_t i);
 static arl_error _grow_array_capacity(arl_ptr l);
+static arl_error _make_array_unique(arl_ptr l);
+static bool _is_array_shared(arl_ptr l);
+static void _release_shared_array(arl_ptr l);
+// File utils
+static uint64_t _type_tag(void);
+static void _file_header_init(struct arl_file_header *header, size_t length,
+                              size_t capacity);
+static arl_error _file_header_validate(const struct arl_file_header *header);
+static uint64_t _checksum_update(uint64_t checksum, const void *data,
+                                 size_t size);
+static uint64_t _checksum_final(uint64_t checksum);
+#ifdef ARL_ENABLE_MMAP
+static size_t _fd_read(void *data, size_t size, void *fd);
+static arl_error _create_reserved(arl_ptr *l, size_t default_capacity,
+                                  size_t max_capacity,
+                                  enum arl_storage storage);
+// Storage utils
+static arl_error _mapping_create_file(struct arl_mapping *mapping,
+                                      const char *path, size_t capacity,
+                                      size_t *length);
+static arl_error _mapping_open_readonly(struct arl_mapping *mapping,
+                                        const char *path);
+static arl_error _mapping_validate(struct arl_mapping *mapping);
+static arl_error _mapping_grow(struct arl_mapping *mapping, size_t new_size);
+static arl_error _mapping_create_reserved(struct arl_mapping *mapping,
+                                          size_t size, size_t page_size);
+static arl_error _mapping_commit(struct arl_mapping *mapping, size_t size);
+static void _mapping_release(struct arl_mapping *mapping, size_t start,
+                             size_t end);
+static bool _is_storage_reserved(arl_ptr l);
+static void _mapping_destroy(struct arl_mapping *mapping);
+static size_t _file_size(size_t capacity);
+#endif
+#ifdef ARL_ENABLE_INCREMENTAL
+// Migration utils
+static arl_error _grow_incremental(arl_ptr l, size_t new_capacity);
+static void _migration_step(arl_ptr l);
+static void _migration_finish(arl_ptr l);
+static void _migration_truncate(arl_ptr l);
+#endif
+#ifdef ARL_STATS
+// Stats utils
+static void _stats_lock(void);
+static void _stats_unlock(void);
+static void _stats_register(arl_ptr l);
+static void _stats_unregister(arl_ptr l);
+static void _stats_count_growth(arl_ptr l, size_t bytes);
+static void _stats_add(struct arl_stats *sum, const struct arl_stats *stats);
+#endif
 static arl_error _move_elements_right(arl_ptr l, size_t start_i,
                                       size_t move_by);
 static arl_error _move_elements_left(arl_ptr l, size_t start_i, size_t move_by);
@@ -84,6 +337,91 @@ static void _move_array_elements_rstart(ARL_VALUE_TYPE dest[],
                                         ARL_VALUE_TYPE src[], size_t n);
 static void _move_array_elements_lstart(ARL_VALUE_TYPE dest[],
                                         ARL_VALUE_TYPE src[], size_t n);
+#ifdef ARL_ENABLE_PARALLEL
+#define ARL_CACHE_LINE_SIZE 64
+
+/* Lists shorter than this are processed by the calling thread only. */
+#ifndef ARL_PARALLEL_MIN_LENGTH
+#define ARL_PARALLEL_MIN_LENGTH 4096
+#endif
+
+/* Each thread gets few ranges, so faster threads take over slower's work. */
+#define ARL_PARALLEL_TASKS_PER_THREAD 4
+
+/* Pool executes one job at a time. Job is split into `tasks_amount` tasks,
+ *  threads claim tasks by incrementing `next_task`. Calling thread works
+ *  on the job too, so pool holds `threads_amount - 1` threads.
+ */
+struct arl_pool {
+  pthread_mutex_t lock;
+  pthread_cond_t job_ready;
+  pthread_cond_t job_done;
+  /* Serializes parallel calls from different threads. */
+  pthread_mutex_t submit_lock;
+
+  pthread_t threads[ARL_PARALLEL_THREADS_MAX];
+  size_t started_amount;
+  size_t threads_amount;
+  bool shutdown;
+  bool exit_registered;
+
+  /* Current job. */
+  void (*task)(size_t task_i, void *arg);
+  void *arg;
+  size_t tasks_amount;
+  size_t next_task;
+  size_t done_tasks;
+  /* Number of pool's threads working on current job. */
+  size_t active_threads;
+  size_t generation;
+};
+
+struct arl_foreach_job {
+  ARL_VALUE_TYPE *array;
+  size_t length;
+  size_t ranges_amount;
+  void (*foreach_callback)(ARL_VALUE_TYPE, void *);
+  ARL_VALUE_TYPE (*map_callback)(ARL_VALUE_TYPE, void *);
+  void *arg;
+};
+
+struct arl_sort_job {
+  ARL_VALUE_TYPE *src;
+  ARL_VALUE_TYPE *dst;
+  size_t length;
+  /* Sorted runs, run k is [bounds[k], bounds[k+1]). */
+  size_t *bounds;
+  size_t runs_amount;
+  size_t ranges_amount;
+  int (*compare)(const void *, const void *);
+};
+
+static struct arl_pool _pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .job_ready = PTHREAD_COND_INITIALIZER,
+    .job_done = PTHREAD_COND_INITIALIZER,
+    .submit_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+// Parallel utils
+static size_t _parallel_threads_amount(void);
+static void _parallel_run(size_t tasks_amount,
+                          void (*task)(size_t task_i, void *arg), void *arg);
+static void _pool_start(size_t threads_amount);
+static void _pool_stop(void);
+static void _pool_exit(void);
+static void *_pool_worker(void *arg);
+static void _get_range(ARL_VALUE_TYPE *array, size_t length,
+                       size_t ranges_amount, size_t k, size_t *start,
+                       size_t *end);
+static void _foreach_task(size_t task_i, void *arg);
+static void _sort_runs_task(size_t task_i, void *arg);
+static void _merge_task(size_t task_i, void *arg);
+static size_t _co_rank(size_t k, ARL_VALUE_TYPE a[], size_t a_len,
+                       ARL_VALUE_TYPE b[], size_t b_len,
+                       int (*compare)(const void *, const void *));
+#endif
+
 // Error utils
 static const char *const ARL_ERROR_STRINGS[] = {
     // 0
@@ -100,7 +438,12 @@ static const char *const ARL_ERROR_STRINGS[] = {
     "Index too big",
     // 6
     "Popping empty list is disallowed",
-
+    // 7
+    "Input/output failure",
+    // 8
+    "Invalid format",
+    // 9
+    "List is read only",
 };
 
 static const size_t ARL_ERROR_STRINGS_LEN =
@@ -130,6 +473,17 @@ arl_error arl_create(arl_ptr *l, size_t default_capacity) {
   l_local->array = (ARL_VALUE_TYPE *)l_array;
   l_local->capacity = default_capacity;
   l_local->length = 0;
+  l_local->refs = NULL;
+  l_local->storage = ARL_STORAGE_HEAP;
+#ifdef ARL_ENABLE_INCREMENTAL
+  l_local->incremental = false;
+  l_local->old_array = NULL;
+#endif
+
+#ifdef ARL_STATS
+  _stats_register(l_local);
+#endif
+  _ARL_PROBE2(create, l_local, l_local->capacity);
 
   *l = l_local;
 
@@ -141,15 +495,446 @@ ERROR_OOM:
   return ARL_ERROR_OUT_OF_MEMORY;
 }
 
+#ifdef ARL_ENABLE_INCREMENTAL
+/* Creates array list's instance growing incrementally (see notes), single
+ *  insert copies at most ARL_INCREMENTAL_STEP elements. List takes up to
+ *  2.5 times more memory while migrating.
+ * Behaviour is undefined if `default_capacity` is equal 0.
+ */
+arl_error arl_create_incremental(arl_ptr *l, size_t default_capacity) {
+  arl_error err;
+
+  err = arl_create(l, default_capacity);
+  if (err)
+    return err;
+
+  (*l)->incremental = true;
+
+  return ARL_SUCCESS;
+}
+#endif
+
 /* Frees resouces allocated for array list's instance.
  */
 arl_error arl_destroy(arl_ptr l) {
-  free(l->array);
+  _ARL_PROBE3(destroy, l, l->length, l->capacity);
+
+#ifdef ARL_STATS
+  _stats_unregister(l);
+#endif
+
+#ifdef ARL_ENABLE_MMAP
+  if (l->storage != ARL_STORAGE_HEAP) {
+    // Keeps file's length up to date.
+    arl_sync(l);
+    _mapping_destroy(&l->mapping);
+    free(l);
+    return ARL_SUCCESS;
+  }
+#endif
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  free(l->old_array);
+#endif
+
+  // Shared storage is freed by the last list using it.
+  if (!l->refs || __atomic_sub_fetch(l->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    free(l->array);
+    free(l->refs);
+  }
+
   free(l);
 
   return ARL_SUCCESS;
 }
 
+/* Creates list's clone, sharing the storage with original list.
+ * Storage is copied by the first list modifying it, so both lists
+ *  can be used (and destroyed) independently.
+ */
+arl_error arl_clone(arl_ptr l, arl_ptr *clone) {
+  arl_ptr l_local;
+
+  // Only heap storage can be shared.
+  if (l->storage != ARL_STORAGE_HEAP)
+    return ARL_ERROR_INVALID_ARGS;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  // Shared array is in one piece.
+  _migration_finish(l);
+#endif
+
+  if (!l->refs) {
+    l->refs = malloc(sizeof(size_t));
+    if (!l->refs)
+      goto ERROR_OOM;
+
+    *l->refs = 1;
+  }
+
+  l_local = malloc(sizeof(struct arl_def));
+  if (!l_local)
+    goto ERROR_OOM;
+
+  __atomic_add_fetch(l->refs, 1, __ATOMIC_RELAXED);
+
+  l_local->array = l->array;
+  l_local->capacity = l->capacity;
+  l_local->length = l->length;
+  l_local->refs = l->refs;
+  l_local->storage = ARL_STORAGE_HEAP;
+#ifdef ARL_ENABLE_INCREMENTAL
+  l_local->incremental = l->incremental;
+  l_local->old_array = NULL;
+#endif
+
+#ifdef ARL_STATS
+  _stats_register(l_local);
+#endif
+  _ARL_PROBE2(create, l_local, l_local->capacity);
+
+  *clone = l_local;
+
+  return ARL_SUCCESS;
+
+ERROR_OOM:
+  return ARL_ERROR_OUT_OF_MEMORY;
+}
+
+/* Writes list to the stream: header (see `struct arl_file_header`) followed
+ *  by the array. Callback gets data in blocks and returns number of written
+ *  bytes, like fwrite. Written list can be mapped by `arl_create_mmap`.
+ */
+arl_error arl_serialize(arl_ptr l,
+                        size_t (*write_callback)(const void *data,
+                                                 size_t size, void *arg),
+                        void *arg) {
+  struct arl_file_header header;
+  const char *data;
+  size_t size = l->length * ARL_VALUE_SIZE, block_size;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+  data = (const char *)l->array;
+
+  _file_header_init(&header, l->length, l->length);
+  header.checksum =
+      _checksum_final(_checksum_update(ARL_CHECKSUM_BASIS, data, size));
+
+  if (write_callback(&header, sizeof(header), arg) != sizeof(header))
+    return ARL_ERROR_IO;
+
+  while (size > 0) {
+    block_size = size < ARL_FILE_BLOCK_SIZE ? size : ARL_FILE_BLOCK_SIZE;
+    if (write_callback(data, block_size, arg) != block_size)
+      return ARL_ERROR_IO;
+
+    data += block_size;
+    size -= block_size;
+  }
+
+  return ARL_SUCCESS;
+}
+
+/* Creates list's instance from the stream written by `arl_serialize`.
+ *  Callback fills data in blocks and returns number of read bytes, like
+ *  fread. Array is allocated once, for exact length read from the header.
+ */
+arl_error arl_deserialize(arl_ptr *l,
+                          size_t (*read_callback)(void *data, size_t size,
+                                                  void *arg),
+                          void *arg) {
+  struct arl_file_header header;
+  size_t size, capacity, block_size;
+  uint64_t checksum = ARL_CHECKSUM_BASIS;
+  arl_ptr l_local;
+  char *data;
+  arl_error err;
+
+  if (read_callback(&header, sizeof(header), arg) != sizeof(header))
+    return ARL_ERROR_IO;
+
+  err = _file_header_validate(&header);
+  if (err)
+    return err;
+
+  if (header.length > ARL_SIZE_T_MAX / ARL_VALUE_SIZE)
+    return ARL_ERROR_OVERFLOW;
+
+  // Empty list still gets place for one element, as arl_create needs it.
+  capacity = header.length ? header.length : 1;
+
+  err = arl_create(&l_local, capacity);
+  if (err)
+    return err;
+
+  data = (char *)l_local->array;
+  size = header.length * ARL_VALUE_SIZE;
+
+  while (size > 0) {
+    block_size = size < ARL_FILE_BLOCK_SIZE ? size : ARL_FILE_BLOCK_SIZE;
+    if (read_callback(data, block_size, arg) != block_size) {
+      err = ARL_ERROR_IO;
+      goto CLEANUP_LIST;
+    }
+
+    checksum = _checksum_update(checksum, data, block_size);
+    data += block_size;
+    size -= block_size;
+  }
+
+  if (header.checksum && header.checksum != _checksum_final(checksum)) {
+    err = ARL_ERROR_INVALID_FORMAT;
+    goto CLEANUP_LIST;
+  }
+
+  l_local->length = header.length;
+
+  *l = l_local;
+
+  return ARL_SUCCESS;
+
+CLEANUP_LIST:
+  arl_destroy(l_local);
+  return err;
+}
+
+#ifdef ARL_ENABLE_MMAP
+/* Creates list's instance, which array lives in the file under the path.
+ * If the file holds a list already, list is restored from it and
+ *  `default_capacity` is ignored, unless the file has no place for elements
+ *  (empty list written by `arl_serialize`). Otherwise the file is created.
+ * Length is written to the file by `arl_sync` and `arl_destroy`.
+ */
+arl_error arl_create_mmap(arl_ptr *l, const char *path,
+                          size_t default_capacity) {
+  struct arl_mapping mapping;
+  arl_ptr l_local;
+  size_t length;
+  arl_error err;
+
+  if (!path || default_capacity == 0)
+    return ARL_ERROR_INVALID_ARGS;
+
+  err = _mapping_create_file(&mapping, path, default_capacity, &length);
+  if (err)
+    return err;
+
+  // List with zero capacity could never grow, see `_count_new_capacity`.
+  if (((struct arl_file_header *)mapping.address)->capacity == 0) {
+    err = _mapping_grow(&mapping, _file_size(default_capacity));
+    if (err)
+      goto CLEANUP_MAPPING;
+
+    ((struct arl_file_header *)mapping.address)->capacity = default_capacity;
+  }
+
+  l_local = malloc(sizeof(struct arl_def));
+  if (!l_local) {
+    err = ARL_ERROR_OUT_OF_MEMORY;
+    goto CLEANUP_MAPPING;
+  }
+
+  l_local->array =
+      (ARL_VALUE_TYPE *)((char *)mapping.address +
+                         sizeof(struct arl_file_header));
+  l_local->capacity =
+      ((struct arl_file_header *)mapping.address)->capacity;
+  l_local->length = length;
+  l_local->refs = NULL;
+  l_local->storage = ARL_STORAGE_FILE;
+  l_local->mapping = mapping;
+#ifdef ARL_ENABLE_INCREMENTAL
+  l_local->incremental = false;
+  l_local->old_array = NULL;
+#endif
+
+#ifdef ARL_STATS
+  _stats_register(l_local);
+#endif
+  _ARL_PROBE2(create, l_local, l_local->capacity);
+
+  *l = l_local;
+
+  return ARL_SUCCESS;
+
+CLEANUP_MAPPING:
+  _mapping_destroy(&mapping);
+  return err;
+}
+
+/* Creates list's instance, which array never moves. Address range for
+ *  `max_capacity` elements is reserved, but only pages holding `capacity`
+ *  elements are made accessible. Growing beyond `max_capacity` fails with
+ *  ARL_ERROR_OVERFLOW.
+ */
+arl_error arl_create_reserved(arl_ptr *l, size_t default_capacity,
+                              size_t max_capacity) {
+  return _create_reserved(l, default_capacity, max_capacity,
+                          ARL_STORAGE_RESERVED);
+}
+
+/* Creates reserved list's instance (see `arl_create_reserved`) meant for
+ *  lists of hundreds of MBs. Array starts on 2MB boundary and grows by 2MB,
+ *  so the kernel can back it with huge pages.
+ */
+arl_error arl_create_large(arl_ptr *l, size_t default_capacity,
+                           size_t max_capacity) {
+  return _create_reserved(l, default_capacity, max_capacity,
+                          ARL_STORAGE_LARGE);
+}
+
+/* Opens list written by `arl_serialize` (or file backed list) without
+ *  reading it. Elements are read straight from the mapped file, list cannot
+ *  be modified. Checksum is not verified, it would read the whole file.
+ */
+arl_error arl_open_readonly(arl_ptr *l, const char *path) {
+  struct arl_mapping mapping;
+  struct arl_file_header *header;
+  arl_ptr l_local;
+  arl_error err;
+
+  if (!path)
+    return ARL_ERROR_INVALID_ARGS;
+
+  err = _mapping_open_readonly(&mapping, path);
+  if (err)
+    return err;
+
+  l_local = malloc(sizeof(struct arl_def));
+  if (!l_local)
+    goto CLEANUP_MAPPING_OOM;
+
+  header = mapping.address;
+
+  l_local->array =
+      (ARL_VALUE_TYPE *)((char *)mapping.address +
+                         sizeof(struct arl_file_header));
+  // Nothing can be appended, so there is no use for bigger capacity.
+  l_local->capacity = header->length;
+  l_local->length = header->length;
+  l_local->refs = NULL;
+  l_local->storage = ARL_STORAGE_READONLY;
+  l_local->mapping = mapping;
+#ifdef ARL_ENABLE_INCREMENTAL
+  l_local->incremental = false;
+  l_local->old_array = NULL;
+#endif
+
+#ifdef ARL_STATS
+  _stats_register(l_local);
+#endif
+  _ARL_PROBE2(create, l_local, l_local->capacity);
+
+  *l = l_local;
+
+  return ARL_SUCCESS;
+
+CLEANUP_MAPPING_OOM:
+  _mapping_destroy(&mapping);
+  return ARL_ERROR_OUT_OF_MEMORY;
+}
+
+/* Passes hint about coming access pattern to the kernel. Hint covers list's
+ *  whole capacity.
+ */
+arl_error arl_advise(arl_ptr l, enum arl_advice advice) {
+  static const int advices[] = {
+      [ARL_ADVICE_NORMAL] = POSIX_MADV_NORMAL,
+      [ARL_ADVICE_SEQUENTIAL] = POSIX_MADV_SEQUENTIAL,
+      [ARL_ADVICE_RANDOM] = POSIX_MADV_RANDOM,
+      [ARL_ADVICE_WILLNEED] = POSIX_MADV_WILLNEED,
+  };
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  uintptr_t start, end;
+
+  if ((int)advice < 0 || advice > ARL_ADVICE_WILLNEED)
+    return ARL_ERROR_INVALID_ARGS;
+
+  if (l->capacity == 0)
+    return ARL_SUCCESS;
+
+  // Advice takes whole pages, heap array may start in the middle of one.
+  start = (uintptr_t)l->array / page_size * page_size;
+  end = (uintptr_t)(l->array + l->capacity);
+
+  if (posix_madvise((void *)start, end - start, advices[advice]))
+    return ARL_ERROR_IO;
+
+  return ARL_SUCCESS;
+}
+
+/* Writes list to the file descriptor, as `arl_serialize` does. Header and
+ *  the array are written with one writev call, unless it is interrupted.
+ */
+arl_error arl_serialize_fd(arl_ptr l, int fd) {
+  struct arl_file_header header;
+  struct iovec iov[2], *iov_p = iov;
+  int iov_amount = 2;
+  ssize_t n;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
+  _file_header_init(&header, l->length, l->length);
+  header.checksum = _checksum_final(_checksum_update(
+      ARL_CHECKSUM_BASIS, l->array, l->length * ARL_VALUE_SIZE));
+
+  iov[0].iov_base = &header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = l->array;
+  iov[1].iov_len = l->length * ARL_VALUE_SIZE;
+
+  while (iov_amount > 0) {
+    n = writev(fd, iov_p, iov_amount);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return ARL_ERROR_IO;
+
+    // Skip what was written, kernel may stop in the middle of a vector.
+    while (iov_amount > 0 && (size_t)n >= iov_p->iov_len) {
+      n -= iov_p->iov_len;
+      iov_p++;
+      iov_amount--;
+    }
+    if (iov_amount > 0) {
+      iov_p->iov_base = (char *)iov_p->iov_base + n;
+      iov_p->iov_len -= n;
+    }
+  }
+
+  return ARL_SUCCESS;
+}
+
+/* Creates list's instance from the file descriptor, as `arl_deserialize`
+ *  does.
+ */
+arl_error arl_deserialize_fd(arl_ptr *l, int fd) {
+  return arl_deserialize(l, _fd_read, &fd);
+}
+
+/* Writes list's length to the file and flushes mapped pages to the disk.
+ * Does nothing for lists not backed by a file.
+ */
+arl_error arl_sync(arl_ptr l) {
+  struct arl_file_header *header;
+
+  if (l->storage != ARL_STORAGE_FILE)
+    return ARL_SUCCESS;
+
+  header = l->mapping.address;
+  header->length = l->length;
+
+  if (msync(l->mapping.address, l->mapping.size, MS_SYNC))
+    return ARL_ERROR_IO;
+
+  return ARL_SUCCESS;
+}
+#endif
+
 /* Returns list's length.
  *
  * !!!WARNING!!!
@@ -203,9 +988,24 @@ arl_error arl_slice(arl_ptr l, size_t start_i, size_t elements_amount,
  * Returns NULL and sets errno on failure.
  */
 arl_error arl_set(arl_ptr l, size_t i, ARL_VALUE_TYPE value) {
+  return arl_set_ptr(l, i, &value);
+}
+
+/* Sets value under the index, value is copied straight from the pointer.
+ * Preferable for big elements (structures), by value functions copy them
+ *  on every call.
+ */
+arl_error arl_set_ptr(arl_ptr l, size_t i,
+                      ARL_VALUE_TYPE const *value) {
+  arl_error err;
+
   if (_is_i_too_big(l, i))
     return ARL_ERROR_INDEX_TOO_BIG;
 
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
   _set(l, i, value);
 
   return ARL_SUCCESS;
@@ -215,25 +1015,60 @@ arl_error arl_set(arl_ptr l, size_t i, ARL_VALUE_TYPE value) {
  * If index bigger than list's length, appends the value.
  */
 arl_error arl_insert(arl_ptr l, size_t i, ARL_VALUE_TYPE value) {
-  size_t new_length, move_by = 1;
+  return arl_insert_ptr(l, i, &value);
+}
+
+/* Insert one element under the index, value is copied straight from the
+ *  pointer. Value can not point into the list, list may be moved before
+ *  the copy.
+ */
+arl_error arl_insert_ptr(arl_ptr l, size_t i,
+                         ARL_VALUE_TYPE const *value) {
+  ARL_VALUE_TYPE *slot;
   arl_error err;
 
-  if (_is_i_too_big(l, i))
-    i = l->length;
+  err = arl_emplace(l, i, &slot);
+  if (err)
+    return err;
 
-  new_length = l->length + move_by;
+  *slot = *value;
 
-  if (new_length > l->capacity) {
-    err = _grow_array_capacity(l);
-    if (err)
+  return ARL_SUCCESS;
+}
+
+/* Makes place for one element under the index, and sets slot to it.
+ *  Element is left uninitialized, so it can be written in place.
+ *  Slot is valid until the next list's modification.
+ * If index bigger than list's length, place is made at the end.
+ */
+arl_error arl_emplace(arl_ptr l, size_t i, ARL_VALUE_TYPE **slot) {
+  size_t new_length, move_by = 1;
+  arl_error err;
+
+  if (_is_i_too_big(l, i))
+    i = l->length;
+
+  new_length = l->length + move_by;
+
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
+  if (new_length > l->capacity) {
+    err = _grow_array_capacity(l);
+    if (err)
       return err;
   }
+#ifdef ARL_ENABLE_INCREMENTAL
+  else
+    _migration_step(l);
+#endif
 
   err = _move_elements_right(l, i, move_by);
   if (err)
     return err;
 
-  _set(l, i, value);
+  *slot = _slot(l, i);
 
   l->length = new_length;
 
@@ -243,7 +1078,20 @@ arl_error arl_insert(arl_ptr l, size_t i, ARL_VALUE_TYPE value) {
 /* Appends one element to the list's end.
  */
 arl_error arl_append(arl_ptr l, ARL_VALUE_TYPE value) {
-  return arl_insert(l, l->length + 1, value);
+  return arl_insert_ptr(l, l->length + 1, &value);
+}
+
+/* Appends one element to the list's end, value is copied straight from
+ *  the pointer. Value can not point into the list.
+ */
+arl_error arl_append_ptr(arl_ptr l, ARL_VALUE_TYPE const *value) {
+  return arl_insert_ptr(l, l->length + 1, value);
+}
+
+/* Makes place for one element at the list's end, see arl_emplace.
+ */
+arl_error arl_emplace_back(arl_ptr l, ARL_VALUE_TYPE **slot) {
+  return arl_emplace(l, l->length + 1, slot);
 }
 
 /* Insert multiple elements. Better optimized for multiple
@@ -261,6 +1109,10 @@ arl_error arl_insert_multi(arl_ptr l, size_t i, size_t v_len,
 
   new_length = l->length + move_by;
 
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
   while (new_length > l->capacity) {
     err = _grow_array_capacity(l);
     if (err)
@@ -272,7 +1124,7 @@ arl_error arl_insert_multi(arl_ptr l, size_t i, size_t v_len,
     return err;
 
   for (k = i; k < i + v_len; k++) {
-    _set(l, k, values[k - i]);
+    _set(l, k, &values[k - i]);
   }
 
   l->length = new_length;
@@ -297,6 +1149,10 @@ arl_error arl_pop(arl_ptr l, size_t i, ARL_VALUE_TYPE *value) {
     return ARL_ERROR_POP_EMPTY_LIST;
   }
 
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
   _get(l, i, &value_holder);
 
   err = _move_elements_left(l, ++i, offset);
@@ -318,6 +1174,10 @@ arl_error arl_pop_multi(arl_ptr l, size_t i, size_t elements_amount,
                         ARL_VALUE_TYPE holder[]) {
   arl_error err;
 
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
   err = arl_slice(l, i, elements_amount, holder);
   if (err)
     return err;
@@ -350,15 +1210,56 @@ arl_error arl_remove(arl_ptr l, size_t i, void (*callback)(ARL_VALUE_TYPE)) {
   return ARL_SUCCESS;
 }
 
+/* Removes element from under the index.
+ * Executes callback function on pointer to the element, before it is
+ *  removed, only if callback is not NULL. Element is not copied.
+ */
+arl_error arl_remove_ptr(arl_ptr l, size_t i,
+                         void (*callback)(ARL_VALUE_TYPE *)) {
+  const size_t offset = 1;
+  arl_error err;
+
+  if (_is_i_too_big(l, i))
+    i = l->length - 1;
+  if (l->length == 0) {
+    return ARL_ERROR_POP_EMPTY_LIST;
+  }
+
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
+  if (callback)
+    callback(_slot(l, i));
+
+  return _move_elements_left(l, ++i, offset);
+}
+
 /* Removes all elements from the list.
  * Executes callback function on each removed element,
  *  only if callback is not NULL.
+ * Shared array is not copied, list gets new empty array of the same
+ *  capacity instead.
  */
 arl_error arl_clear(arl_ptr l, void (*callback)(ARL_VALUE_TYPE)) {
   size_t i;
   ARL_VALUE_TYPE value;
+  void *p = NULL;
   arl_error err;
 
+  _ARL_PROBE2(clear, l, l->length);
+
+  if (_is_array_shared(l)) {
+    // Allocated upfront, so failure leaves elements untouched.
+    p = malloc(l->capacity * ARL_VALUE_SIZE);
+    if (!p)
+      return ARL_ERROR_OUT_OF_MEMORY;
+  } else {
+    err = _make_array_unique(l);
+    if (err)
+      return err;
+  }
+
   // POP MULTI is not used here to avoid extra loop iteration and
   // some memory. Slicing is unnecessary from clear's point of view.
   if (callback) {
@@ -368,14 +1269,345 @@ arl_error arl_clear(arl_ptr l, void (*callback)(ARL_VALUE_TYPE)) {
     }
   }
 
+  if (p) {
+#ifdef ARL_STATS
+    _stats_count_growth(l, l->capacity * ARL_VALUE_SIZE);
+#endif
+    _release_shared_array(l);
+    l->array = p;
+    l->length = 0;
+
+    return ARL_SUCCESS;
+  }
+
   err = _move_elements_left(l, l->length, l->length);
   if (err)
     return err;
 
   l->length = 0;
 
+#ifdef ARL_ENABLE_MMAP
+  if (_is_storage_reserved(l))
+    _mapping_release(&l->mapping, 0, l->capacity * ARL_VALUE_SIZE);
+#endif
+
+  return ARL_SUCCESS;
+}
+
+/* Removes all elements from the list.
+ * Executes callback function on pointer to each removed element,
+ *  only if callback is not NULL. Elements are not copied.
+ * Callback may modify elements, so shared array is copied for it.
+ */
+arl_error arl_clear_ptr(arl_ptr l, void (*callback)(ARL_VALUE_TYPE *)) {
+  size_t i;
+  arl_error err;
+
+  if (callback) {
+    err = _make_array_unique(l);
+    if (err)
+      return err;
+
+    for (i = 0; i < l->length; i++) {
+      callback(_slot(l, i));
+    }
+  }
+
+  return arl_clear(l, NULL);
+}
+
+/* Frees memory not used by list's elements.
+ * Heap array is reallocated to list's length, reserved storage keeps its
+ *  capacity and address, but gives unused pages back to the system. Files
+ *  are not truncated.
+ */
+arl_error arl_shrink(arl_ptr l) {
+  size_t new_capacity;
+  void *p;
+  arl_error err;
+
+#ifdef ARL_ENABLE_MMAP
+  if (_is_storage_reserved(l)) {
+    _mapping_release(&l->mapping, l->length * ARL_VALUE_SIZE,
+                     l->capacity * ARL_VALUE_SIZE);
+    return ARL_SUCCESS;
+  }
+
+  if (l->storage != ARL_STORAGE_HEAP)
+    return ARL_SUCCESS;
+#endif
+
+  // Empty list keeps one element, so growing it still works.
+  new_capacity = l->length ? l->length : 1;
+  if (new_capacity >= l->capacity)
+    return ARL_SUCCESS;
+
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
+  p = realloc(l->array, new_capacity * ARL_VALUE_SIZE);
+  if (!p)
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  l->capacity = new_capacity;
+  l->array = p;
+
+#ifdef ARL_STATS
+  _stats_count_growth(l, new_capacity * ARL_VALUE_SIZE);
+#endif
+
+  return ARL_SUCCESS;
+}
+
+#ifdef ARL_STATS
+/*******************************************************************************
+ *    STATS API
+ ******************************************************************************/
+
+/* Fills stats with list's counters.
+ */
+arl_error arl_stats(arl_ptr l, struct arl_stats *stats) {
+  if (!stats)
+    return ARL_ERROR_INVALID_ARGS;
+
+  *stats = l->stats;
+  stats->wasted_capacity = l->capacity - l->length;
+
+  return ARL_SUCCESS;
+}
+
+/* Fills stats with counters of all lists, destroyed ones included. Peak
+ *  capacity is the biggest one of any list, wasted capacity is summed over
+ *  live lists.
+ */
+void arl_stats_global(struct arl_stats *stats) {
+  struct arl_stats list_stats;
+  arl_ptr l;
+
+  _stats_lock();
+
+  *stats = _stats_registry.destroyed;
+  for (l = _stats_registry.lists; l; l = l->stats_next) {
+    arl_stats(l, &list_stats);
+    _stats_add(stats, &list_stats);
+  }
+
+  _stats_unlock();
+}
+
+/* Writes counters of each live list and global ones to the file, one line
+ *  each.
+ */
+arl_error arl_stats_dump(FILE *file) {
+  struct arl_stats stats;
+  arl_error err = ARL_SUCCESS;
+  arl_ptr l;
+
+  _stats_lock();
+
+  for (l = _stats_registry.lists; l; l = l->stats_next) {
+    arl_stats(l, &stats);
+    if (fprintf(file,
+                "arl %p: length %zu, capacity %zu, reallocs %zu (%zu bytes), "
+                "shifted right %zu, shifted left %zu, peak capacity %zu, "
+                "wasted capacity %zu\n",
+                (void *)l, l->length, l->capacity, stats.reallocs,
+                stats.realloc_bytes, stats.shifted_right, stats.shifted_left,
+                stats.peak_capacity, stats.wasted_capacity) < 0)
+      err = ARL_ERROR_IO;
+  }
+
+  _stats_unlock();
+
+  arl_stats_global(&stats);
+  if (fprintf(file,
+              "arl total: reallocs %zu (%zu bytes), shifted right %zu, "
+              "shifted left %zu, peak capacity %zu, wasted capacity %zu\n",
+              stats.reallocs, stats.realloc_bytes, stats.shifted_right,
+              stats.shifted_left, stats.peak_capacity,
+              stats.wasted_capacity) < 0)
+    err = ARL_ERROR_IO;
+
+  return err;
+}
+#endif
+
+#ifdef ARL_ENABLE_PARALLEL
+/*******************************************************************************
+ *    PARALLEL API
+ ******************************************************************************/
+
+/* Sets number of threads used by parallel functions, calling thread
+ *  included. 0 stands for number of online processors, which is the default.
+ *  Running pool is stopped and restarted on the next parallel call.
+ *  Cannot be called concurrently with parallel functions.
+ */
+arl_error arl_parallel_set_threads(size_t threads_amount) {
+  if (threads_amount > ARL_PARALLEL_THREADS_MAX)
+    return ARL_ERROR_INVALID_ARGS;
+
+  pthread_mutex_lock(&_pool.submit_lock);
+
+  _pool_stop();
+  _pool.threads_amount = threads_amount;
+
+  pthread_mutex_unlock(&_pool.submit_lock);
+
+  return ARL_SUCCESS;
+}
+
+/* Sorts the list in place. Compare function has qsort's semantics and
+ *  gets pointers to the elements. Like qsort, sort is not stable.
+ *  Compare is called from many threads at once.
+ */
+arl_error arl_parallel_sort(arl_ptr l,
+                            int (*compare)(const void *, const void *)) {
+  struct arl_sort_job job;
+  size_t threads_amount, k, *new_bounds;
+  ARL_VALUE_TYPE *buffer;
+  ARL_VALUE_TYPE *tmp;
+  arl_error err;
+
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
+  threads_amount = _parallel_threads_amount();
+
+  if (l->length < ARL_PARALLEL_MIN_LENGTH || threads_amount < 2) {
+    qsort(l->array, l->length, ARL_VALUE_SIZE, compare);
+    return ARL_SUCCESS;
+  }
+
+  // Buffer has list's capacity, so it can replace list's array.
+  buffer = malloc(l->capacity * ARL_VALUE_SIZE);
+  if (!buffer)
+    goto ERROR_OOM;
+
+  job.bounds = malloc((threads_amount + 1) * sizeof(size_t));
+  if (!job.bounds)
+    goto CLEANUP_BUFFER_OOM;
+
+  job.src = l->array;
+  job.dst = buffer;
+  job.length = l->length;
+  job.runs_amount = threads_amount;
+  job.ranges_amount = threads_amount;
+  job.compare = compare;
+
+  for (k = 0; k < job.runs_amount; k++) {
+    _get_range(job.src, job.length, job.ranges_amount, k, &job.bounds[k],
+               &job.bounds[k + 1]);
+  }
+
+  _parallel_run(job.runs_amount, _sort_runs_task, &job);
+
+  job.ranges_amount = threads_amount * ARL_PARALLEL_TASKS_PER_THREAD;
+
+  while (job.runs_amount > 1) {
+    _parallel_run(job.ranges_amount, _merge_task, &job);
+
+    // Pairs of runs became single runs.
+    new_bounds = job.bounds;
+    for (k = 0; k < job.runs_amount; k += 2) {
+      *new_bounds++ = job.bounds[k];
+    }
+    *new_bounds = job.length;
+    job.runs_amount = (job.runs_amount + 1) / 2;
+
+    tmp = job.src;
+    job.src = job.dst;
+    job.dst = tmp;
+  }
+
+  free(job.bounds);
+
+  if (job.src == buffer && l->storage != ARL_STORAGE_HEAP) {
+    // Mapped array cannot be replaced, sorted elements are copied back.
+    memcpy(l->array, buffer, l->length * ARL_VALUE_SIZE);
+    free(buffer);
+  } else {
+    // Array holding sorted elements becomes list's array.
+    free(job.dst);
+    l->array = job.src;
+  }
+
+  return ARL_SUCCESS;
+
+CLEANUP_BUFFER_OOM:
+  free(buffer);
+ERROR_OOM:
+  return ARL_ERROR_OUT_OF_MEMORY;
+}
+
+/* Executes callback on each element. Callback is called from many threads
+ *  at once, order of calls is unspecified.
+ */
+arl_error arl_parallel_foreach(arl_ptr l,
+                               void (*callback)(ARL_VALUE_TYPE, void *),
+                               void *arg) {
+  struct arl_foreach_job job = {
+      .length = l->length,
+      .foreach_callback = callback,
+      .arg = arg,
+  };
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
+  job.array = l->array;
+  job.ranges_amount =
+      _parallel_threads_amount() * ARL_PARALLEL_TASKS_PER_THREAD;
+  if (l->length < ARL_PARALLEL_MIN_LENGTH)
+    job.ranges_amount = 1;
+
+  _parallel_run(job.ranges_amount, _foreach_task, &job);
+
+  return ARL_SUCCESS;
+}
+
+/* Replaces each element with callback's result. Callback is called from
+ *  many threads at once, order of calls is unspecified.
+ */
+arl_error arl_parallel_map(arl_ptr l,
+                           ARL_VALUE_TYPE (*callback)(ARL_VALUE_TYPE, void *),
+                           void *arg) {
+  struct arl_foreach_job job = {
+      .length = l->length,
+      .map_callback = callback,
+      .arg = arg,
+  };
+  arl_error err;
+
+  err = _make_array_unique(l);
+  if (err)
+    return err;
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
+  job.array = l->array;
+  job.ranges_amount =
+      _parallel_threads_amount() * ARL_PARALLEL_TASKS_PER_THREAD;
+  if (l->length < ARL_PARALLEL_MIN_LENGTH)
+    job.ranges_amount = 1;
+
+  _parallel_run(job.ranges_amount, _foreach_task, &job);
+
   return ARL_SUCCESS;
 }
+#endif
 
 /*******************************************************************************
  *    ERRORS UTILS
@@ -399,8 +1631,22 @@ const char *arl_strerror(arl_error error) {
 /*******************************************************************************
  *    PRIVATE API
  ******************************************************************************/
-void _get(arl_ptr l, size_t i, ARL_VALUE_TYPE *value) { *value = l->array[i]; }
-void _set(arl_ptr l, size_t i, ARL_VALUE_TYPE value) { l->array[i] = value; }
+void _get(arl_ptr l, size_t i, ARL_VALUE_TYPE *value) { *value = *_slot(l, i); }
+void _set(arl_ptr l, size_t i, ARL_VALUE_TYPE const *value) {
+  *_slot(l, i) = *value;
+}
+
+/* Address of element under the index, it may still be in the old array
+ *  while migrating.
+ */
+ARL_VALUE_TYPE *_slot(arl_ptr l, size_t i) {
+#ifdef ARL_ENABLE_INCREMENTAL
+  if (l->old_array && i >= l->migrated && i < l->migration_end)
+    return &l->old_array[i];
+#endif
+
+  return &l->array[i];
+}
 
 /* Checks if index is within list boundaries.
  * The behaviour is undefined if is not a valid pointer.
@@ -437,33 +1683,224 @@ arl_error _grow_array_capacity(arl_ptr l) {
   if (err)
     return err;
 
+  // Probe `grow_start` fires after validation, every growth it starts ends
+  //  with `grow_done` or `grow_failed`.
+#ifdef ARL_ENABLE_MMAP
+  if (l->storage == ARL_STORAGE_FILE) {
+    if (_is_overflow_size_t_multi(new_capacity, ARL_VALUE_SIZE) ||
+        _is_overflow_size_t_add(new_capacity * ARL_VALUE_SIZE,
+                                sizeof(struct arl_file_header)))
+      return ARL_ERROR_OVERFLOW;
+
+    _ARL_PROBE3(grow_start, l, l->capacity, new_capacity);
+
+    err = _mapping_grow(&l->mapping, _file_size(new_capacity));
+    if (err) {
+      _ARL_PROBE2(grow_failed, l, err);
+      return err;
+    }
+
+    ((struct arl_file_header *)l->mapping.address)->capacity = new_capacity;
+    l->array = (ARL_VALUE_TYPE *)((char *)l->mapping.address +
+                                  sizeof(struct arl_file_header));
+    l->capacity = new_capacity;
+
+#ifdef ARL_STATS
+    _stats_count_growth(l, _file_size(new_capacity));
+#endif
+    _ARL_PROBE2(grow_done, l, l->capacity);
+
+    return ARL_SUCCESS;
+  }
+
+  if (_is_storage_reserved(l)) {
+    if (l->capacity >= l->max_capacity)
+      return ARL_ERROR_OVERFLOW;
+
+    if (new_capacity > l->max_capacity)
+      new_capacity = l->max_capacity;
+
+    _ARL_PROBE3(grow_start, l, l->capacity, new_capacity);
+
+    // Array stays in place, only new pages become accessible.
+    err = _mapping_commit(&l->mapping, new_capacity * ARL_VALUE_SIZE);
+    if (err) {
+      _ARL_PROBE2(grow_failed, l, err);
+      return err;
+    }
+
+    l->capacity = new_capacity;
+
+#ifdef ARL_STATS
+    // Nothing is reallocated.
+    _stats_count_growth(l, 0);
+#endif
+    _ARL_PROBE2(grow_done, l, l->capacity);
+
+    return ARL_SUCCESS;
+  }
+#endif
+
+  _ARL_PROBE3(grow_start, l, l->capacity, new_capacity);
+
+#ifdef ARL_ENABLE_INCREMENTAL
+  if (l->incremental) {
+    err = _grow_incremental(l, new_capacity);
+    if (err)
+      _ARL_PROBE2(grow_failed, l, err);
+
+    return err;
+  }
+#endif
+
   p = realloc(l->array, new_capacity * ARL_VALUE_SIZE);
   if (!p) {
+    _ARL_PROBE2(grow_failed, l, ARL_ERROR_OUT_OF_MEMORY);
     return ARL_ERROR_OUT_OF_MEMORY;
   }
 
   l->capacity = new_capacity;
   l->array = p;
 
+#ifdef ARL_STATS
+  _stats_count_growth(l, new_capacity * ARL_VALUE_SIZE);
+#endif
+  _ARL_PROBE2(grow_done, l, l->capacity);
+
   return ARL_SUCCESS;
 };
 
-/* Move elements to the right by `move_by`, starting from `start_i`.
- * Ex:
- *    INPUT  l.array {0, 1, 2, , ,}, start_i 1, move_by 2
- *    OUTPUT l.array {0, , , 1, 2}
+#ifdef ARL_ENABLE_MMAP
+/* Creates list's instance in reserved address range, see
+ *  `arl_create_reserved`.
  */
-arl_error _move_elements_right(arl_ptr l, size_t start_i, size_t move_by) {
+arl_error _create_reserved(arl_ptr *l, size_t default_capacity,
+                           size_t max_capacity, enum arl_storage storage) {
+  struct arl_mapping mapping;
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  arl_ptr l_local;
+  arl_error err;
 
-  size_t new_length, elements_to_move_amount;
+  if (default_capacity == 0 || max_capacity < default_capacity)
+    return ARL_ERROR_INVALID_ARGS;
 
-  // Idea is to detect all failures upfront so recovery from half moved
-  // array
-  //  is not required.
-  if (_is_overflow_size_t_add(l->length, move_by))
+  if (_is_overflow_size_t_multi(max_capacity, ARL_VALUE_SIZE))
     return ARL_ERROR_OVERFLOW;
 
-  new_length = l->length + move_by;
+  if (storage == ARL_STORAGE_LARGE)
+    page_size = ARL_LARGE_PAGE_SIZE;
+
+  err = _mapping_create_reserved(&mapping, max_capacity * ARL_VALUE_SIZE,
+                                 page_size);
+  if (err)
+    return err;
+
+  err = _mapping_commit(&mapping, default_capacity * ARL_VALUE_SIZE);
+  if (err)
+    goto CLEANUP_MAPPING;
+
+  l_local = malloc(sizeof(struct arl_def));
+  if (!l_local) {
+    err = ARL_ERROR_OUT_OF_MEMORY;
+    goto CLEANUP_MAPPING;
+  }
+
+  l_local->array = mapping.address;
+  l_local->capacity = default_capacity;
+  l_local->length = 0;
+  l_local->refs = NULL;
+  l_local->storage = storage;
+  l_local->mapping = mapping;
+  l_local->max_capacity = max_capacity;
+#ifdef ARL_ENABLE_INCREMENTAL
+  l_local->incremental = false;
+  l_local->old_array = NULL;
+#endif
+
+#ifdef ARL_STATS
+  _stats_register(l_local);
+#endif
+  _ARL_PROBE2(create, l_local, l_local->capacity);
+
+  *l = l_local;
+
+  return ARL_SUCCESS;
+
+CLEANUP_MAPPING:
+  _mapping_destroy(&mapping);
+  return err;
+}
+
+#endif
+
+/* Copies the storage if other lists share it. Has to be called before
+ *  modifying the array, fails if the array cannot be modified at all.
+ */
+arl_error _make_array_unique(arl_ptr l) {
+  void *p;
+
+  if (l->storage == ARL_STORAGE_READONLY)
+    return ARL_ERROR_READ_ONLY;
+
+  if (!l->refs)
+    return ARL_SUCCESS;
+
+  // Other lists released the storage, nothing to copy.
+  if (__atomic_load_n(l->refs, __ATOMIC_ACQUIRE) == 1) {
+    free(l->refs);
+    l->refs = NULL;
+    return ARL_SUCCESS;
+  }
+
+  // Capacity cannot overflow, it is already allocated by the original list.
+  p = malloc(l->capacity * ARL_VALUE_SIZE);
+  if (!p)
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  memcpy(p, l->array, l->length * ARL_VALUE_SIZE);
+
+#ifdef ARL_STATS
+  _stats_count_growth(l, l->capacity * ARL_VALUE_SIZE);
+#endif
+
+  _release_shared_array(l);
+  l->array = p;
+
+  return ARL_SUCCESS;
+}
+
+bool _is_array_shared(arl_ptr l) {
+  return l->refs && __atomic_load_n(l->refs, __ATOMIC_ACQUIRE) > 1;
+}
+
+/* Drops list's reference to the shared array, last list frees it.
+ * Other lists may have released the storage meanwhile.
+ */
+void _release_shared_array(arl_ptr l) {
+  if (__atomic_sub_fetch(l->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+    free(l->array);
+    free(l->refs);
+  }
+
+  l->refs = NULL;
+}
+
+/* Move elements to the right by `move_by`, starting from `start_i`.
+ * Ex:
+ *    INPUT  l.array {0, 1, 2, , ,}, start_i 1, move_by 2
+ *    OUTPUT l.array {0, , , 1, 2}
+ */
+arl_error _move_elements_right(arl_ptr l, size_t start_i, size_t move_by) {
+
+  size_t new_length, elements_to_move_amount;
+
+  // Idea is to detect all failures upfront so recovery from half moved
+  // array
+  //  is not required.
+  if (_is_overflow_size_t_add(l->length, move_by))
+    return ARL_ERROR_OVERFLOW;
+
+  new_length = l->length + move_by;
 
   if (new_length > (l->capacity))
     return ARL_ERROR_INVALID_ARGS;
@@ -476,9 +1913,18 @@ arl_error _move_elements_right(arl_ptr l, size_t start_i, size_t move_by) {
   if (elements_to_move_amount == 0)
     return ARL_SUCCESS;
 
+#ifdef ARL_ENABLE_INCREMENTAL
+  _migration_finish(l);
+#endif
+
   _move_array_elements_rstart(l->array + start_i + move_by, l->array + start_i,
                               elements_to_move_amount);
 
+#ifdef ARL_STATS
+  l->stats.shifted_right += elements_to_move_amount;
+#endif
+  _ARL_PROBE2(shift_right, l, elements_to_move_amount);
+
   l->length = new_length;
 
   return ARL_SUCCESS;
@@ -496,7 +1942,8 @@ arl_error _move_elements_left(arl_ptr l, size_t start_i, size_t move_by) {
    */
 
   size_t new_length, elements_to_move_amount;
-  ARL_VALUE_TYPE *src, *dst;
+  ARL_VALUE_TYPE *src;
+  ARL_VALUE_TYPE *dst;
 
   // Do not allow reading before list's start.
   if (move_by > start_i)
@@ -517,8 +1964,16 @@ arl_error _move_elements_left(arl_ptr l, size_t start_i, size_t move_by) {
   elements_to_move_amount = l->length - start_i;
 
   if (start_i < l->length) {
+#ifdef ARL_ENABLE_INCREMENTAL
+    _migration_finish(l);
+#endif
     src = l->array + start_i;
     dst = src - move_by;
+
+#ifdef ARL_STATS
+    l->stats.shifted_left += elements_to_move_amount;
+#endif
+    _ARL_PROBE2(shift_left, l, elements_to_move_amount);
   } else {
     // Allow deleting last element.
     // TO-DO too hackish, find cleaner solution
@@ -531,9 +1986,534 @@ arl_error _move_elements_left(arl_ptr l, size_t start_i, size_t move_by) {
 
   l->length = new_length;
 
+#ifdef ARL_ENABLE_INCREMENTAL
+  // Elements popped from the end do not need migration.
+  _migration_truncate(l);
+#endif
+
+  return ARL_SUCCESS;
+}
+
+#ifdef ARL_ENABLE_INCREMENTAL
+/*******************************************************************************
+ *    MIGRATION UTILS
+ ******************************************************************************/
+/* Grows incrementally, new array is allocated and elements are left in the
+ *  old one, see notes. Migration still in progress is finished first.
+ */
+arl_error _grow_incremental(arl_ptr l, size_t new_capacity) {
+  void *p;
+
+  if (_is_overflow_size_t_multi(new_capacity, ARL_VALUE_SIZE))
+    return ARL_ERROR_OVERFLOW;
+
+  _migration_finish(l);
+
+  p = malloc(new_capacity * ARL_VALUE_SIZE);
+  if (!p)
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  l->old_array = l->array;
+  l->migrated = 0;
+  l->migration_end = l->length;
+  l->array = p;
+  l->capacity = new_capacity;
+
+#ifdef ARL_STATS
+  _stats_count_growth(l, new_capacity * ARL_VALUE_SIZE);
+#endif
+  _ARL_PROBE2(grow_done, l, l->capacity);
+
+  _migration_truncate(l);
+
   return ARL_SUCCESS;
 }
 
+/* Migrates up to ARL_INCREMENTAL_STEP elements to the new array. */
+void _migration_step(arl_ptr l) {
+  size_t n;
+
+  if (!l->old_array)
+    return;
+
+  n = l->migration_end - l->migrated;
+  if (n > ARL_INCREMENTAL_STEP)
+    n = ARL_INCREMENTAL_STEP;
+
+  memcpy(l->array + l->migrated, l->old_array + l->migrated,
+         n * ARL_VALUE_SIZE);
+  l->migrated += n;
+
+  _migration_truncate(l);
+}
+
+/* Migrates all remaining elements. */
+void _migration_finish(arl_ptr l) {
+  if (!l->old_array)
+    return;
+
+  memcpy(l->array + l->migrated, l->old_array + l->migrated,
+         (l->migration_end - l->migrated) * ARL_VALUE_SIZE);
+  l->migrated = l->migration_end;
+
+  _migration_truncate(l);
+}
+
+/* Drops elements removed from the list from migration, frees the old array
+ *  when nothing is left to migrate.
+ */
+void _migration_truncate(arl_ptr l) {
+  if (!l->old_array)
+    return;
+
+  if (l->migration_end > l->length)
+    l->migration_end = l->length;
+
+  if (l->migrated < l->migration_end)
+    return;
+
+  free(l->old_array);
+  l->old_array = NULL;
+}
+#endif
+
+#ifdef ARL_STATS
+/*******************************************************************************
+ *    STATS UTILS
+ ******************************************************************************/
+void _stats_lock(void) {
+  while (__atomic_test_and_set(&_stats_registry.lock, __ATOMIC_ACQUIRE))
+    ;
+}
+
+void _stats_unlock(void) {
+  __atomic_clear(&_stats_registry.lock, __ATOMIC_RELEASE);
+}
+
+/* Starts list's counters and links it into the registry. */
+void _stats_register(arl_ptr l) {
+  memset(&l->stats, 0, sizeof(l->stats));
+  l->stats.peak_capacity = l->capacity;
+
+  _stats_lock();
+
+  l->stats_prev = NULL;
+  l->stats_next = _stats_registry.lists;
+  if (_stats_registry.lists)
+    _stats_registry.lists->stats_prev = l;
+  _stats_registry.lists = l;
+
+  _stats_unlock();
+}
+
+/* Unlinks list from the registry, its counters go to the global ones. */
+void _stats_unregister(arl_ptr l) {
+  struct arl_stats stats = l->stats;
+
+  // Memory of destroyed list is not wasted anymore.
+  stats.wasted_capacity = 0;
+
+  _stats_lock();
+
+  if (l->stats_prev)
+    l->stats_prev->stats_next = l->stats_next;
+  else
+    _stats_registry.lists = l->stats_next;
+  if (l->stats_next)
+    l->stats_next->stats_prev = l->stats_prev;
+
+  _stats_add(&_stats_registry.destroyed, &stats);
+
+  _stats_unlock();
+}
+
+/* Counts array's reallocation to `bytes` (0 if array was not reallocated)
+ *  and updates peak capacity.
+ */
+void _stats_count_growth(arl_ptr l, size_t bytes) {
+  if (bytes) {
+    l->stats.reallocs++;
+    l->stats.realloc_bytes += bytes;
+  }
+
+  if (l->capacity > l->stats.peak_capacity)
+    l->stats.peak_capacity = l->capacity;
+}
+
+void _stats_add(struct arl_stats *sum, const struct arl_stats *stats) {
+  sum->reallocs += stats->reallocs;
+  sum->realloc_bytes += stats->realloc_bytes;
+  sum->shifted_right += stats->shifted_right;
+  sum->shifted_left += stats->shifted_left;
+  sum->wasted_capacity += stats->wasted_capacity;
+
+  if (stats->peak_capacity > sum->peak_capacity)
+    sum->peak_capacity = stats->peak_capacity;
+}
+#endif
+
+/*******************************************************************************
+ *    FILE UTILS
+ ******************************************************************************/
+
+/* FNV-1a hash of element type's spelling, ex. "float". Lists generated
+ *  for different types do not read each other's files. generate_sources.py
+ *  computes the same hash for generated type and defines it as ARL_TYPE_TAG.
+ */
+uint64_t _type_tag(void) {
+#ifdef ARL_TYPE_TAG
+  return ARL_TYPE_TAG;
+#else
+  const char *type_name = _ARL_TO_STRING(ARL_VALUE_TYPE);
+  uint64_t hash = ARL_CHECKSUM_BASIS;
+
+  while (*type_name) {
+    hash ^= (unsigned char)*type_name++;
+    hash *= ARL_CHECKSUM_PRIME;
+  }
+
+  return hash;
+#endif
+}
+
+void _file_header_init(struct arl_file_header *header, size_t length,
+                       size_t capacity) {
+  memset(header, 0, sizeof(struct arl_file_header));
+  memcpy(header->magic, ARL_FILE_MAGIC, sizeof(ARL_FILE_MAGIC));
+  header->version = ARL_FILE_VERSION;
+  header->endianness = ARL_FILE_ENDIANNESS;
+  header->value_size = ARL_VALUE_SIZE;
+  header->type_tag = _type_tag();
+  header->length = length;
+  header->capacity = capacity;
+}
+
+/* Checks whether header describes list of this type, written on machine
+ *  with the same endianness.
+ */
+arl_error _file_header_validate(const struct arl_file_header *header) {
+  if (memcmp(header->magic, ARL_FILE_MAGIC, sizeof(ARL_FILE_MAGIC)) ||
+      header->version != ARL_FILE_VERSION ||
+      header->endianness != ARL_FILE_ENDIANNESS ||
+      header->value_size != ARL_VALUE_SIZE ||
+      header->type_tag != _type_tag() || header->length > header->capacity)
+    return ARL_ERROR_INVALID_FORMAT;
+
+  return ARL_SUCCESS;
+}
+
+/* FNV-1a variant taking 8 bytes at once. Data may be passed in parts, all
+ *  parts except the last one have to be multiples of 8 bytes.
+ */
+uint64_t _checksum_update(uint64_t checksum, const void *data, size_t size) {
+  const unsigned char *bytes = data;
+  uint64_t word;
+
+  while (size >= sizeof(word)) {
+    memcpy(&word, bytes, sizeof(word));
+    checksum = (checksum ^ word) * ARL_CHECKSUM_PRIME;
+    // Multiplication moves bits up only, fold high bits back.
+    checksum ^= checksum >> 32;
+    bytes += sizeof(word);
+    size -= sizeof(word);
+  }
+
+  while (size--) {
+    checksum = (checksum ^ *bytes++) * ARL_CHECKSUM_PRIME;
+  }
+
+  return checksum;
+}
+
+/* 0 in the header stands for not computed checksum. */
+uint64_t _checksum_final(uint64_t checksum) { return checksum ? checksum : 1; }
+
+#ifdef ARL_ENABLE_MMAP
+/* Reads `size` bytes, unless end of file or error comes first. */
+size_t _fd_read(void *data, size_t size, void *fd) {
+  size_t done = 0;
+  ssize_t n;
+
+  while (done < size) {
+    n = read(*(int *)fd, (char *)data + done, size - done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+
+    done += n;
+  }
+
+  return done;
+}
+
+/*******************************************************************************
+ *    STORAGE UTILS
+ ******************************************************************************/
+
+size_t _file_size(size_t capacity) {
+  return sizeof(struct arl_file_header) + capacity * ARL_VALUE_SIZE;
+}
+
+/* Maps list's file, creating it if it's empty. Sets length to the length
+ *  stored in the file.
+ */
+arl_error _mapping_create_file(struct arl_mapping *mapping, const char *path,
+                               size_t capacity, size_t *length) {
+  struct arl_file_header *header;
+  struct stat file_stat;
+  bool is_new;
+  arl_error err;
+
+  if (_is_overflow_size_t_multi(capacity, ARL_VALUE_SIZE) ||
+      _is_overflow_size_t_add(capacity * ARL_VALUE_SIZE,
+                              sizeof(struct arl_file_header)))
+    return ARL_ERROR_OVERFLOW;
+
+  mapping->fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (mapping->fd < 0)
+    return ARL_ERROR_IO;
+
+  if (fstat(mapping->fd, &file_stat)) {
+    err = ARL_ERROR_IO;
+    goto CLEANUP_FD;
+  }
+
+  is_new = file_stat.st_size == 0;
+
+  if (is_new) {
+    mapping->size = _file_size(capacity);
+    if (ftruncate(mapping->fd, mapping->size)) {
+      err = ARL_ERROR_IO;
+      goto CLEANUP_FD;
+    }
+  } else if ((size_t)file_stat.st_size < sizeof(struct arl_file_header)) {
+    err = ARL_ERROR_INVALID_FORMAT;
+    goto CLEANUP_FD;
+  } else {
+    mapping->size = file_stat.st_size;
+  }
+
+  mapping->page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+  mapping->address = mmap(NULL, mapping->size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, mapping->fd, 0);
+  if (mapping->address == MAP_FAILED) {
+    err = ARL_ERROR_IO;
+    goto CLEANUP_FD;
+  }
+
+  header = mapping->address;
+
+  if (is_new) {
+    _file_header_init(header, 0, capacity);
+  } else {
+    err = _mapping_validate(mapping);
+    if (err)
+      goto CLEANUP_MAPPING;
+
+    // Array is modified in place, checksum would not keep up.
+    header->checksum = 0;
+  }
+
+  *length = header->length;
+
+  return ARL_SUCCESS;
+
+CLEANUP_MAPPING:
+  munmap(mapping->address, mapping->size);
+CLEANUP_FD:
+  close(mapping->fd);
+  return err;
+}
+
+/* Maps list's file for reading. File descriptor is not kept, mapping
+ *  holds the file.
+ */
+arl_error _mapping_open_readonly(struct arl_mapping *mapping,
+                                 const char *path) {
+  struct stat file_stat;
+  arl_error err;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return ARL_ERROR_IO;
+
+  if (fstat(fd, &file_stat)) {
+    err = ARL_ERROR_IO;
+    goto CLEANUP_FD;
+  }
+
+  if ((size_t)file_stat.st_size < sizeof(struct arl_file_header)) {
+    err = ARL_ERROR_INVALID_FORMAT;
+    goto CLEANUP_FD;
+  }
+
+  mapping->size = file_stat.st_size;
+  mapping->page_size = (size_t)sysconf(_SC_PAGESIZE);
+  mapping->fd = -1;
+  mapping->address = mmap(NULL, mapping->size, PROT_READ, MAP_SHARED, fd, 0);
+  if (mapping->address == MAP_FAILED) {
+    err = ARL_ERROR_IO;
+    goto CLEANUP_FD;
+  }
+
+  close(fd);
+
+  err = _mapping_validate(mapping);
+  if (err)
+    _mapping_destroy(mapping);
+
+  return err;
+
+CLEANUP_FD:
+  close(fd);
+  return err;
+}
+
+/* Checks mapped file's header. File cannot be shorter than the array it
+ *  claims to hold.
+ */
+arl_error _mapping_validate(struct arl_mapping *mapping) {
+  struct arl_file_header *header = mapping->address;
+  arl_error err;
+
+  err = _file_header_validate(header);
+  if (err)
+    return err;
+
+  if (header->capacity > (mapping->size - sizeof(struct arl_file_header)) /
+                             ARL_VALUE_SIZE)
+    return ARL_ERROR_INVALID_FORMAT;
+
+  return ARL_SUCCESS;
+}
+
+/* Extends the mapping (and the file behind it) to the new size. Mapping's
+ *  address may change.
+ */
+arl_error _mapping_grow(struct arl_mapping *mapping, size_t new_size) {
+  void *p;
+
+  if (mapping->fd >= 0 && ftruncate(mapping->fd, new_size))
+    return ARL_ERROR_IO;
+
+#ifdef MREMAP_MAYMOVE
+  p = mremap(mapping->address, mapping->size, new_size, MREMAP_MAYMOVE);
+#else
+  p = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+  if (p != MAP_FAILED)
+    munmap(mapping->address, mapping->size);
+#endif
+  if (p == MAP_FAILED)
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  mapping->address = p;
+  mapping->size = new_size;
+
+  return ARL_SUCCESS;
+}
+
+/* Reserves anonymous address range of at least `size` bytes, aligned to
+ *  `page_size`. None of its pages is accessible, until it is commited.
+ */
+arl_error _mapping_create_reserved(struct arl_mapping *mapping, size_t size,
+                                   size_t page_size) {
+  size_t system_page_size = (size_t)sysconf(_SC_PAGESIZE), head, extra = 0;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  char *p;
+
+  if (page_size > system_page_size)
+    extra = page_size;
+
+  if (_is_overflow_size_t_add(size, page_size - 1) ||
+      _is_overflow_size_t_add((size + page_size - 1) / page_size * page_size,
+                              extra))
+    return ARL_ERROR_OVERFLOW;
+
+#ifdef MAP_NORESERVE
+  // Reservation is not counted as used memory, commited pages are.
+  flags |= MAP_NORESERVE;
+#endif
+
+  mapping->size = (size + page_size - 1) / page_size * page_size;
+  mapping->page_size = page_size;
+  mapping->fd = -1;
+
+  // Over-reserve by one page, so aligned range fits in.
+  p = mmap(NULL, mapping->size + extra, PROT_NONE, flags, -1, 0);
+  if (p == MAP_FAILED)
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  if (extra) {
+    head = (page_size - (uintptr_t)p % page_size) % page_size;
+    if (head)
+      munmap(p, head);
+    if (extra - head)
+      munmap(p + head + mapping->size, extra - head);
+    p += head;
+  }
+
+  mapping->address = p;
+
+#ifdef MADV_HUGEPAGE
+  // Best effort, kernel may have transparent huge pages disabled.
+  if (page_size == ARL_LARGE_PAGE_SIZE)
+    madvise(mapping->address, mapping->size, MADV_HUGEPAGE);
+#endif
+
+  return ARL_SUCCESS;
+}
+
+/* Makes first `size` bytes of reserved mapping accessible. `size` cannot be
+ *  bigger than mapping's size.
+ */
+arl_error _mapping_commit(struct arl_mapping *mapping, size_t size) {
+  size_t page_size = mapping->page_size;
+
+  // Mapping's size is a multiple of page's size, rounding cannot exceed it.
+  size = (size + page_size - 1) / page_size * page_size;
+
+  if (mprotect(mapping->address, size, PROT_READ | PROT_WRITE))
+    return ARL_ERROR_OUT_OF_MEMORY;
+
+  return ARL_SUCCESS;
+}
+
+/* Gives pages between `start` and `end` bytes back to the system. Pages stay
+ *  accessible and read as zeros. Pages holding `start` and `end` are kept.
+ */
+void _mapping_release(struct arl_mapping *mapping, size_t start, size_t end) {
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+  start = (start + page_size - 1) / page_size * page_size;
+  end = end / page_size * page_size;
+
+  if (start >= end)
+    return;
+
+#ifdef MADV_DONTNEED
+  madvise((char *)mapping->address + start, end - start, MADV_DONTNEED);
+#else
+  // Advice only, memory may stay resident.
+  posix_madvise((char *)mapping->address + start, end - start,
+                POSIX_MADV_DONTNEED);
+#endif
+}
+
+bool _is_storage_reserved(arl_ptr l) {
+  return l->storage == ARL_STORAGE_RESERVED || l->storage == ARL_STORAGE_LARGE;
+}
+
+void _mapping_destroy(struct arl_mapping *mapping) {
+  munmap(mapping->address, mapping->size);
+
+  if (mapping->fd >= 0)
+    close(mapping->fd);
+}
+#endif
+
 /*******************************************************************************
  *    OVERFLOW UTILS
  ******************************************************************************/
@@ -591,3 +2571,297 @@ void _move_array_elements_lstart(ARL_VALUE_TYPE dest[], ARL_VALUE_TYPE src[],
 #endif
   }
 }
+
+#ifdef ARL_ENABLE_PARALLEL
+/*******************************************************************************
+ *    PARALLEL UTILS
+ ******************************************************************************/
+
+size_t _parallel_threads_amount(void) {
+  long processors;
+
+  if (_pool.threads_amount)
+    return _pool.threads_amount;
+
+  processors = sysconf(_SC_NPROCESSORS_ONLN);
+  if (processors < 1)
+    return 1;
+  if ((size_t)processors > ARL_PARALLEL_THREADS_MAX)
+    return ARL_PARALLEL_THREADS_MAX;
+
+  return (size_t)processors;
+}
+
+/* Executes tasks 0..tasks_amount-1 on the pool and the calling thread.
+ * Returns once all tasks are done.
+ */
+void _parallel_run(size_t tasks_amount, void (*task)(size_t task_i, void *arg),
+                   void *arg) {
+  size_t task_i;
+
+  if (tasks_amount == 1) {
+    task(0, arg);
+    return;
+  }
+
+  pthread_mutex_lock(&_pool.submit_lock);
+
+  if (_pool.started_amount + 1 < _parallel_threads_amount())
+    _pool_start(_parallel_threads_amount() - 1);
+
+  pthread_mutex_lock(&_pool.lock);
+  // Thread which woke up late may still be inside of the previous job.
+  while (_pool.active_threads) {
+    pthread_cond_wait(&_pool.job_done, &_pool.lock);
+  }
+  _pool.task = task;
+  _pool.arg = arg;
+  _pool.tasks_amount = tasks_amount;
+  _pool.next_task = 0;
+  _pool.done_tasks = 0;
+  _pool.generation++;
+  pthread_cond_broadcast(&_pool.job_ready);
+  pthread_mutex_unlock(&_pool.lock);
+
+  while ((task_i = __atomic_fetch_add(&_pool.next_task, 1, __ATOMIC_RELAXED)) <
+         tasks_amount) {
+    task(task_i, arg);
+    __atomic_add_fetch(&_pool.done_tasks, 1, __ATOMIC_RELEASE);
+  }
+
+  // Threads still inside the job would claim tasks of the next one.
+  pthread_mutex_lock(&_pool.lock);
+  while (__atomic_load_n(&_pool.done_tasks, __ATOMIC_ACQUIRE) < tasks_amount ||
+         _pool.active_threads) {
+    pthread_cond_wait(&_pool.job_done, &_pool.lock);
+  }
+  pthread_mutex_unlock(&_pool.lock);
+
+  pthread_mutex_unlock(&_pool.submit_lock);
+}
+
+/* Starts missing threads. If system refuses new threads, pool works with
+ *  the ones it has. Caller has to hold submit lock.
+ */
+void _pool_start(size_t threads_amount) {
+  // Threads are joined at exit, not left running under exit handlers.
+  if (!_pool.exit_registered && atexit(_pool_exit) == 0)
+    _pool.exit_registered = true;
+
+  while (_pool.started_amount < threads_amount) {
+    if (pthread_create(&_pool.threads[_pool.started_amount], NULL,
+                       _pool_worker, NULL))
+      break;
+
+    _pool.started_amount++;
+  }
+}
+
+/* Stops and joins all threads. Caller has to hold submit lock.
+ */
+void _pool_stop(void) {
+  size_t i;
+
+  pthread_mutex_lock(&_pool.lock);
+  _pool.shutdown = true;
+  pthread_cond_broadcast(&_pool.job_ready);
+  pthread_mutex_unlock(&_pool.lock);
+
+  for (i = 0; i < _pool.started_amount; i++) {
+    pthread_join(_pool.threads[i], NULL);
+  }
+
+  _pool.started_amount = 0;
+  _pool.shutdown = false;
+}
+
+/* Stops the pool at process exit. Pool busy with a parallel call (exit
+ *  called by other thread or by a task) is left to the process' end.
+ */
+void _pool_exit(void) {
+  if (pthread_mutex_trylock(&_pool.submit_lock))
+    return;
+
+  _pool_stop();
+
+  pthread_mutex_unlock(&_pool.submit_lock);
+}
+
+void *_pool_worker(void *unused) {
+  void (*task)(size_t task_i, void *arg);
+  size_t generation, tasks_amount, task_i;
+  void *arg;
+
+  (void)unused;
+
+  pthread_mutex_lock(&_pool.lock);
+  generation = _pool.generation;
+
+  for (;;) {
+    while (_pool.generation == generation && !_pool.shutdown) {
+      pthread_cond_wait(&_pool.job_ready, &_pool.lock);
+    }
+
+    if (_pool.shutdown)
+      break;
+
+    generation = _pool.generation;
+    task = _pool.task;
+    arg = _pool.arg;
+    tasks_amount = _pool.tasks_amount;
+    _pool.active_threads++;
+    pthread_mutex_unlock(&_pool.lock);
+
+    while ((task_i = __atomic_fetch_add(&_pool.next_task, 1,
+                                        __ATOMIC_RELAXED)) < tasks_amount) {
+      task(task_i, arg);
+      __atomic_add_fetch(&_pool.done_tasks, 1, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_lock(&_pool.lock);
+    _pool.active_threads--;
+    pthread_cond_signal(&_pool.job_done);
+  }
+
+  pthread_mutex_unlock(&_pool.lock);
+
+  return NULL;
+}
+
+/* Counts k-th of `ranges_amount` ranges covering the array. Ranges
+ *  (except the first and the last) start on cache line's boundary.
+ */
+void _get_range(ARL_VALUE_TYPE *array, size_t length, size_t ranges_amount,
+                size_t k, size_t *start, size_t *end) {
+  size_t line_elements = 1, head = 0, chunk, boundaries[2], i;
+
+  if (ARL_CACHE_LINE_SIZE % ARL_VALUE_SIZE == 0) {
+    line_elements = ARL_CACHE_LINE_SIZE / ARL_VALUE_SIZE;
+    // Elements before the first line's boundary.
+    head = (ARL_CACHE_LINE_SIZE - (uintptr_t)array % ARL_CACHE_LINE_SIZE) %
+           ARL_CACHE_LINE_SIZE / ARL_VALUE_SIZE;
+  }
+
+  if (head > length)
+    head = length;
+
+  chunk = (length + ranges_amount - 1) / ranges_amount;
+  chunk = (chunk + line_elements - 1) / line_elements * line_elements;
+  if (chunk == 0)
+    chunk = 1;
+
+  for (i = 0; i < 2; i++) {
+    if (k + i == 0)
+      boundaries[i] = 0;
+    else if (k + i >= ranges_amount ||
+             (length - head) / chunk < k + i) // Avoids overflow.
+      boundaries[i] = length;
+    else
+      boundaries[i] = head + (k + i) * chunk;
+
+    if (boundaries[i] > length)
+      boundaries[i] = length;
+  }
+
+  *start = boundaries[0];
+  *end = boundaries[1];
+}
+
+void _foreach_task(size_t task_i, void *arg) {
+  struct arl_foreach_job *job = arg;
+  size_t start, end, i;
+
+  _get_range(job->array, job->length, job->ranges_amount, task_i, &start,
+             &end);
+
+  if (job->map_callback) {
+    for (i = start; i < end; i++) {
+      job->array[i] = job->map_callback(job->array[i], job->arg);
+    }
+  } else {
+    for (i = start; i < end; i++) {
+      job->foreach_callback(job->array[i], job->arg);
+    }
+  }
+}
+
+void _sort_runs_task(size_t task_i, void *arg) {
+  struct arl_sort_job *job = arg;
+  size_t start = job->bounds[task_i], end = job->bounds[task_i + 1];
+
+  qsort(job->src + start, end - start, ARL_VALUE_SIZE, job->compare);
+}
+
+/* Fills task's range of the destination by merging pairs of runs.
+ * Range may cover parts of few pairs.
+ */
+void _merge_task(size_t task_i, void *arg) {
+  struct arl_sort_job *job = arg;
+  size_t start, end, pair_start, pair_middle, pair_end, k;
+  size_t from, till, a_i, b_i, a_end, b_end, out_i;
+  // Separate declarations, ARL_VALUE_TYPE may itself be a pointer.
+  ARL_VALUE_TYPE *a;
+  ARL_VALUE_TYPE *b;
+
+  _get_range(job->dst, job->length, job->ranges_amount, task_i, &start, &end);
+
+  for (k = 0; k < job->runs_amount; k += 2) {
+    pair_start = job->bounds[k];
+    pair_middle = job->bounds[k + 1];
+    pair_end = k + 2 <= job->runs_amount ? job->bounds[k + 2] : pair_middle;
+
+    if (pair_end <= start || pair_start >= end)
+      continue;
+
+    from = start > pair_start ? start : pair_start;
+    till = end < pair_end ? end : pair_end;
+
+    a = job->src + pair_start;
+    b = job->src + pair_middle;
+    a_end = pair_middle - pair_start;
+    b_end = pair_end - pair_middle;
+
+    a_i = _co_rank(from - pair_start, a, a_end, b, b_end, job->compare);
+    b_i = from - pair_start - a_i;
+
+    for (out_i = from; out_i < till; out_i++) {
+      // Ties are taken from the first run, merge stays stable.
+      if (b_i < b_end &&
+          (a_i >= a_end || job->compare(&b[b_i], &a[a_i]) < 0))
+        job->dst[out_i] = b[b_i++];
+      else
+        job->dst[out_i] = a[a_i++];
+    }
+  }
+}
+
+/* Counts how many of the first `k` merged elements come from `a`.
+ */
+size_t _co_rank(size_t k, ARL_VALUE_TYPE a[], size_t a_len, ARL_VALUE_TYPE b[],
+                size_t b_len, int (*compare)(const void *, const void *)) {
+  size_t i, j, i_low, j_low, delta;
+
+  i = k < a_len ? k : a_len;
+  j = k - i;
+  i_low = k > b_len ? k - b_len : 0;
+  j_low = k > a_len ? k - a_len : 0;
+
+  for (;;) {
+    if (i > 0 && j < b_len && compare(&a[i - 1], &b[j]) > 0) {
+      // Too many elements taken from `a`.
+      delta = (i - i_low + 1) / 2;
+      j_low = j;
+      i -= delta;
+      j += delta;
+    } else if (j > 0 && i < a_len && compare(&b[j - 1], &a[i]) >= 0) {
+      // Too many elements taken from `b`.
+      delta = (j - j_low + 1) / 2;
+      i_low = i;
+      i += delta;
+      j -= delta;
+    } else {
+      return i;
+    }
+  }
+}
+#endif
@@ -0,0 +1,508 @@
+/* Compressed integer list. Values are kept in blocks of 128, each block is */
+/*  bit-packed with frame of reference or delta encoding.                    */
+
+/* Lists of integer IDs often hold values close to each other (or sorted),
+ * so most of each value's bits are the same. This list stores:
+ * - Full blocks of CIL_BLOCK_LENGTH values, bit-packed into 64 bit words.
+ *     Each block picks the encoding giving fewer bits per value:
+ *       frame of reference - values minus block's minimum,
+ *       delta - differences between neighbours, only for non-decreasing
+ *         blocks (sorted IDs).
+ *     128 values of `bits` width take exactly `2 * bits` words, so block's
+ *     data never shares a word with other block.
+ * - Block directory, entry per full block with it's base, width, encoding
+ *     and position of it's words. Index is mapped to block by division,
+ *     directory entry acts as a skip pointer, no other block is touched.
+ * - Tail buffer with values not filling a block yet, kept uncompressed.
+ *     Block is packed when the tail is full and next value arrives.
+ */
+
+/* Notes:
+ * - Frame of reference gives constant time `get`. Delta block has to sum
+ *     deltas before the index, up to 127 additions.
+ * - Values are converted to uint64_t. Differences are computed modulo 2^64,
+ *     so signed types work as long as they have at most 64 bits.
+ * - Packing loops work on fixed block length with no branches on data,
+ *     which is the shape compilers vectorize best.
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "cil_list.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define CIL_WORD_BITS 64
+#define CIL_MIN_CAPACITY 8
+
+/* Values wider than 64 bits cannot be packed. */
+typedef char _cil_value_size_check[CIL_VALUE_SIZE <= 8 ? 1 : -1];
+
+enum cil_encoding {
+  CIL_ENCODING_FOR = 0,
+  CIL_ENCODING_DELTA,
+};
+
+struct cil_block {
+  /* Minimum (frame of reference) or first value (delta). */
+  uint64_t base;
+
+  /* Index of block's first word. */
+  size_t offset;
+
+  /* Width of packed values, 0 - 64. */
+  unsigned char bits;
+
+  unsigned char encoding;
+};
+
+struct cil_def {
+  /* Number of elements.*/
+  size_t length;
+
+  /* Block directory. */
+  struct cil_block *blocks;
+  size_t blocks_length;
+  size_t blocks_capacity;
+
+  /* Packed values of all blocks. */
+  uint64_t *words;
+  size_t words_length;
+  size_t words_capacity;
+
+  /* Values which do not fill a block yet. */
+  CIL_VALUE_TYPE tail[CIL_BLOCK_LENGTH];
+  size_t tail_length;
+};
+
+static cil_error _pack_tail(cil_ptr l);
+static void _choose_encoding(CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH],
+                             struct cil_block *block);
+static void _decode(cil_ptr l, const struct cil_block *block,
+                    CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH]);
+static uint64_t _unpack(const uint64_t *words, size_t position,
+                        unsigned char bits);
+static unsigned char _bits_width(uint64_t value);
+static cil_error _reserve(void **array, size_t *capacity, size_t length,
+                          size_t element_size);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const CIL_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Index too big",
+};
+
+static const size_t CIL_ERROR_STRINGS_LEN =
+    sizeof(CIL_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates compressed list's instance. No memory for elements is allocated
+ *  until the first block is full.
+ */
+cil_error cil_create(cil_ptr *l) {
+  cil_ptr l_local;
+
+  l_local = malloc(sizeof(struct cil_def));
+  if (!l_local)
+    return CIL_ERROR_OUT_OF_MEMORY;
+
+  l_local->length = 0;
+  l_local->blocks = NULL;
+  l_local->blocks_length = 0;
+  l_local->blocks_capacity = 0;
+  l_local->words = NULL;
+  l_local->words_length = 0;
+  l_local->words_capacity = 0;
+  l_local->tail_length = 0;
+
+  *l = l_local;
+
+  return CIL_SUCCESS;
+}
+
+/* Frees resouces allocated for list's instance.
+ */
+cil_error cil_destroy(cil_ptr l) {
+  free(l->blocks);
+  free(l->words);
+  free(l);
+
+  return CIL_SUCCESS;
+}
+
+/* Returns list's length.
+ * Does not return error, to be usable in for loop (see arl_length).
+ */
+size_t cil_length(cil_ptr l) { return l->length; }
+
+/* Returns number of bytes allocated for list's instance.
+ */
+size_t cil_memory_usage(cil_ptr l) {
+  return sizeof(struct cil_def) +
+         l->blocks_capacity * sizeof(struct cil_block) +
+         l->words_capacity * sizeof(uint64_t);
+}
+
+/* Gets value under the index. Only the block holding the value is read.
+ */
+cil_error cil_get(cil_ptr l, size_t i, CIL_VALUE_TYPE *value) {
+  const struct cil_block *block;
+  size_t block_i, k, j;
+  uint64_t result;
+
+  if (i >= l->length)
+    return CIL_ERROR_INDEX_TOO_BIG;
+
+  block_i = i / CIL_BLOCK_LENGTH;
+  k = i % CIL_BLOCK_LENGTH;
+
+  if (block_i == l->blocks_length) {
+    *value = l->tail[k];
+    return CIL_SUCCESS;
+  }
+
+  block = &l->blocks[block_i];
+
+  if (block->encoding == CIL_ENCODING_FOR) {
+    result = block->base + _unpack(l->words + block->offset, k * block->bits,
+                                   block->bits);
+  } else {
+    // First delta is always 0.
+    result = block->base;
+    for (j = 1; j <= k; j++) {
+      result += _unpack(l->words + block->offset, j * block->bits,
+                        block->bits);
+    }
+  }
+
+  *value = (CIL_VALUE_TYPE)result;
+
+  return CIL_SUCCESS;
+}
+
+/* Returns number of blocks, the last one may be partially filled.
+ */
+size_t cil_blocks_amount(cil_ptr l) {
+  return l->blocks_length + (l->tail_length ? 1 : 0);
+}
+
+/* Decodes whole block into values. Values amount is set to number of values
+ *  in the block, CIL_BLOCK_LENGTH for all blocks except the last one.
+ */
+cil_error cil_decode_block(cil_ptr l, size_t block_i,
+                           CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH],
+                           size_t *values_amount) {
+  if (block_i >= cil_blocks_amount(l))
+    return CIL_ERROR_INDEX_TOO_BIG;
+
+  if (block_i == l->blocks_length) {
+    memcpy(values, l->tail, l->tail_length * CIL_VALUE_SIZE);
+    *values_amount = l->tail_length;
+    return CIL_SUCCESS;
+  }
+
+  _decode(l, &l->blocks[block_i], values);
+  *values_amount = CIL_BLOCK_LENGTH;
+
+  return CIL_SUCCESS;
+}
+
+/* Executes callback on each element, in order. Blocks are decoded one at a
+ *  time, into a buffer on the stack.
+ */
+cil_error cil_foreach(cil_ptr l, void (*callback)(CIL_VALUE_TYPE, void *),
+                      void *arg) {
+  CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH];
+  size_t block_i, values_amount, k;
+
+  if (!callback)
+    return CIL_ERROR_INVALID_ARGS;
+
+  for (block_i = 0; block_i < cil_blocks_amount(l); block_i++) {
+    cil_decode_block(l, block_i, values, &values_amount);
+
+    for (k = 0; k < values_amount; k++) {
+      callback(values[k], arg);
+    }
+  }
+
+  return CIL_SUCCESS;
+}
+
+/* Appends one element to the list's end.
+ */
+cil_error cil_append(cil_ptr l, CIL_VALUE_TYPE value) {
+  cil_error err;
+
+  if (l->tail_length == CIL_BLOCK_LENGTH) {
+    err = _pack_tail(l);
+    if (err)
+      return err;
+  }
+
+  l->tail[l->tail_length++] = value;
+  l->length++;
+
+  return CIL_SUCCESS;
+}
+
+/* Appends multiple elements. On failure elements appended before it stay
+ *  in the list.
+ */
+cil_error cil_append_multi(cil_ptr l, size_t v_len, CIL_VALUE_TYPE values[]) {
+  size_t i;
+  cil_error err;
+
+  for (i = 0; i < v_len; i++) {
+    err = cil_append(l, values[i]);
+    if (err)
+      return err;
+  }
+
+  return CIL_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *cil_strerror(cil_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= CIL_ERROR_LEN) || (error >= CIL_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return CIL_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Packs full tail into a new block. List is unchanged on failure.
+ */
+cil_error _pack_tail(cil_ptr l) {
+  uint64_t packed[CIL_BLOCK_LENGTH], value, *words;
+  struct cil_block block;
+  size_t k, position, words_amount;
+  cil_error err;
+
+  _choose_encoding(l->tail, &block);
+
+  for (k = 0; k < CIL_BLOCK_LENGTH; k++) {
+    value = (uint64_t)l->tail[k];
+    if (block.encoding == CIL_ENCODING_FOR)
+      packed[k] = value - block.base;
+    else
+      packed[k] = k ? value - (uint64_t)l->tail[k - 1] : 0;
+  }
+
+  words_amount = 2 * (size_t)block.bits;
+
+  if (_is_overflow_size_t_add(l->words_length, words_amount))
+    return CIL_ERROR_OVERFLOW;
+
+  err = _reserve((void **)&l->words, &l->words_capacity,
+                 l->words_length + words_amount, sizeof(uint64_t));
+  if (err)
+    return err;
+
+  err = _reserve((void **)&l->blocks, &l->blocks_capacity,
+                 l->blocks_length + 1, sizeof(struct cil_block));
+  if (err)
+    return err;
+
+  block.offset = l->words_length;
+  words = l->words + block.offset;
+
+  // Block of equal values (or step) has no words at all.
+  for (k = 0; k < words_amount; k++) {
+    words[k] = 0;
+  }
+
+  for (k = 0, position = 0; block.bits && k < CIL_BLOCK_LENGTH;
+       k++, position += block.bits) {
+    words[position / CIL_WORD_BITS] |= packed[k] << position % CIL_WORD_BITS;
+
+    // Value crosses words' boundary.
+    if (position % CIL_WORD_BITS + block.bits > CIL_WORD_BITS)
+      words[position / CIL_WORD_BITS + 1] |=
+          packed[k] >> (CIL_WORD_BITS - position % CIL_WORD_BITS);
+  }
+
+  l->words_length += words_amount;
+  l->blocks[l->blocks_length++] = block;
+  l->tail_length = 0;
+
+  return CIL_SUCCESS;
+}
+
+/* Sets block's encoding, base and width to the ones giving narrowest
+ *  packed values.
+ */
+void _choose_encoding(CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH],
+                      struct cil_block *block) {
+  CIL_VALUE_TYPE min = values[0], max = values[0];
+  uint64_t deltas = 0;
+  bool is_sorted = true;
+  unsigned char delta_bits;
+  size_t k;
+
+  for (k = 1; k < CIL_BLOCK_LENGTH; k++) {
+    if (values[k] < min)
+      min = values[k];
+    if (values[k] > max)
+      max = values[k];
+    if (values[k] < values[k - 1])
+      is_sorted = false;
+
+    // Width depends on the highest bit only.
+    deltas |= (uint64_t)values[k] - (uint64_t)values[k - 1];
+  }
+
+  block->encoding = CIL_ENCODING_FOR;
+  block->base = (uint64_t)min;
+  block->bits = _bits_width((uint64_t)max - (uint64_t)min);
+
+  if (!is_sorted)
+    return;
+
+  delta_bits = _bits_width(deltas);
+  if (delta_bits < block->bits) {
+    block->encoding = CIL_ENCODING_DELTA;
+    block->base = (uint64_t)values[0];
+    block->bits = delta_bits;
+  }
+}
+
+void _decode(cil_ptr l, const struct cil_block *block,
+             CIL_VALUE_TYPE values[CIL_BLOCK_LENGTH]) {
+  const uint64_t *words = l->words + block->offset;
+  uint64_t unpacked[CIL_BLOCK_LENGTH], sum;
+  size_t k, position;
+
+  for (k = 0, position = 0; k < CIL_BLOCK_LENGTH;
+       k++, position += block->bits) {
+    unpacked[k] = _unpack(words, position, block->bits);
+  }
+
+  if (block->encoding == CIL_ENCODING_FOR) {
+    for (k = 0; k < CIL_BLOCK_LENGTH; k++) {
+      values[k] = (CIL_VALUE_TYPE)(block->base + unpacked[k]);
+    }
+  } else {
+    sum = block->base;
+    for (k = 0; k < CIL_BLOCK_LENGTH; k++) {
+      sum += unpacked[k];
+      values[k] = (CIL_VALUE_TYPE)sum;
+    }
+  }
+}
+
+/* Reads `bits` wide value starting at bit `position`.
+ */
+uint64_t _unpack(const uint64_t *words, size_t position, unsigned char bits) {
+  size_t word_i = position / CIL_WORD_BITS, shift = position % CIL_WORD_BITS;
+  uint64_t value;
+
+  if (bits == 0)
+    return 0;
+
+  value = words[word_i] >> shift;
+
+  // Value crosses words' boundary.
+  if (shift + bits > CIL_WORD_BITS)
+    value |= words[word_i + 1] << (CIL_WORD_BITS - shift);
+
+  if (bits < CIL_WORD_BITS)
+    value &= ((uint64_t)1 << bits) - 1;
+
+  return value;
+}
+
+/* Number of bits needed to store the value.
+ */
+unsigned char _bits_width(uint64_t value) {
+  unsigned char bits = 0;
+
+  while (value) {
+    bits++;
+    value >>= 1;
+  }
+
+  return bits;
+}
+
+/* Makes sure array has place for `length` elements, doubling capacity.
+ */
+cil_error _reserve(void **array, size_t *capacity, size_t length,
+                   size_t element_size) {
+  size_t new_capacity = *capacity ? *capacity : CIL_MIN_CAPACITY;
+  void *p;
+
+  if (length <= *capacity)
+    return CIL_SUCCESS;
+
+  while (new_capacity < length) {
+    if (_is_overflow_size_t_multi(new_capacity, 2))
+      return CIL_ERROR_OVERFLOW;
+    new_capacity *= 2;
+  }
+
+  if (_is_overflow_size_t_multi(new_capacity, element_size))
+    return CIL_ERROR_OVERFLOW;
+
+  p = realloc(*array, new_capacity * element_size);
+  if (!p)
+    return CIL_ERROR_OUT_OF_MEMORY;
+
+  *array = p;
+  *capacity = new_capacity;
+
+  return CIL_SUCCESS;
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, CIL_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, CIL_SIZE_T_MAX);
+}
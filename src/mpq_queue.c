@@ -0,0 +1,290 @@
+/* Bounded multi-producer/multi-consumer queue, as described here: */
+/*   https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue */
+
+/* Queue is one continous array of cells. Each cell carries a sequence number
+ * next to the value. The sequence tells whether cell is ready to be written by
+ * producer at position `pos` (sequence == pos) or ready to be read by consumer
+ * at position `pos` (sequence == pos + 1). Producers and consumers claim
+ * positions with compare and swap on two separate counters, so the only
+ * contention is between producers (or between consumers) themselves.
+ * Capacity is rounded up to power of two, so position's cell is found by
+ * masking instead of dividing.
+ */
+
+/* Notes:
+ * - Atomics are done by GCC's `__atomic` builtins (supported by clang too),
+ *     so the queue still compiles as C99.
+ * - Values are stored inside of cells, so small types (`int`, `char`) travel
+ *     by value, the same way as in arl_list.
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+// App
+#include "mpq_queue.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define MPQ_CACHE_LINE_SIZE 64
+
+struct mpq_cell {
+  size_t sequence;
+  MPQ_VALUE_TYPE value;
+};
+
+/* Counters live on separate cache lines, so producers do not invalidate
+ * consumers' line on every push (and vice versa).
+ */
+struct mpq_def {
+  char _pad0[MPQ_CACHE_LINE_SIZE];
+
+  /* Next position to be written by a producer. */
+  size_t enqueue_pos;
+  char _pad1[MPQ_CACHE_LINE_SIZE - sizeof(size_t)];
+
+  /* Next position to be read by a consumer. */
+  size_t dequeue_pos;
+  char _pad2[MPQ_CACHE_LINE_SIZE - sizeof(size_t)];
+
+  /* Capacity - 1. */
+  size_t mask;
+
+  /* Storage. */
+  struct mpq_cell *cells;
+};
+
+static mpq_error _count_capacity(size_t requested, size_t *capacity);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+
+// Error utils
+static const char *const MPQ_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Queue is full",
+    // 5
+    "Queue is empty",
+};
+
+static const size_t MPQ_ERROR_STRINGS_LEN =
+    sizeof(MPQ_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates queue's instance.
+ * Capacity is rounded up to the nearest power of two, minimum is 2.
+ */
+mpq_error mpq_create(mpq_ptr *q, size_t capacity) {
+  struct mpq_cell *cells;
+  mpq_ptr q_local;
+  mpq_error err;
+  size_t i;
+
+  if (capacity == 0)
+    return MPQ_ERROR_INVALID_ARGS;
+
+  err = _count_capacity(capacity, &capacity);
+  if (err)
+    return err;
+
+  if (_is_overflow_size_t_multi(capacity, sizeof(struct mpq_cell)))
+    return MPQ_ERROR_OVERFLOW;
+
+  cells = malloc(capacity * sizeof(struct mpq_cell));
+  if (!cells)
+    goto ERROR_OOM;
+
+  q_local = malloc(sizeof(struct mpq_def));
+  if (!q_local)
+    goto CLEANUP_CELLS_OOM;
+
+  for (i = 0; i < capacity; i++) {
+    cells[i].sequence = i;
+  }
+
+  q_local->cells = cells;
+  q_local->mask = capacity - 1;
+  q_local->enqueue_pos = 0;
+  q_local->dequeue_pos = 0;
+
+  *q = q_local;
+
+  return MPQ_SUCCESS;
+
+CLEANUP_CELLS_OOM:
+  free(cells);
+ERROR_OOM:
+  return MPQ_ERROR_OUT_OF_MEMORY;
+}
+
+/* Frees resouces allocated for queue's instance.
+ * No thread can use the queue while it's destroyed.
+ */
+mpq_error mpq_destroy(mpq_ptr q) {
+  free(q->cells);
+  free(q);
+
+  return MPQ_SUCCESS;
+}
+
+/* Returns queue's capacity. */
+size_t mpq_capacity(mpq_ptr q) { return q->mask + 1; }
+
+/* Returns number of elements in the queue.
+ *
+ * !!!WARNING!!!
+ * THIS FUNCTION DO NOT RETURN ERROR!!!
+ * !!!WARNING!!!
+ *
+ * While other threads are pushing or popping, the value is only
+ *  a snapshot and may be outdated as soon as it's returned.
+ */
+size_t mpq_length(mpq_ptr q) {
+  size_t enqueue_pos, dequeue_pos;
+
+  dequeue_pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_ACQUIRE);
+  enqueue_pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_ACQUIRE);
+
+  // Consumer may have moved past the producer between the loads.
+  if (dequeue_pos > enqueue_pos)
+    return 0;
+
+  return enqueue_pos - dequeue_pos;
+}
+
+/* Pushes value to the queue's end.
+ * If queue is full, returns MPQ_ERROR_QUEUE_FULL.
+ */
+mpq_error mpq_push(mpq_ptr q, MPQ_VALUE_TYPE value) {
+  struct mpq_cell *cell;
+  size_t pos, sequence;
+  ptrdiff_t diff;
+
+  pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+
+  for (;;) {
+    cell = &q->cells[pos & q->mask];
+    sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+
+    if (diff == 0) {
+      // Cell is free, try to claim the position.
+      if (__atomic_compare_exchange_n(&q->enqueue_pos, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    } else if (diff < 0) {
+      // Cell still holds value from previous lap.
+      return MPQ_ERROR_QUEUE_FULL;
+    } else {
+      // Other producer claimed the position, catch up.
+      pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  cell->value = value;
+  __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+
+  return MPQ_SUCCESS;
+}
+
+/* Pops value from the queue's beginning.
+ * If queue is empty, returns MPQ_ERROR_QUEUE_EMPTY.
+ */
+mpq_error mpq_pop(mpq_ptr q, MPQ_VALUE_TYPE *value) {
+  struct mpq_cell *cell;
+  size_t pos, sequence;
+  ptrdiff_t diff;
+
+  pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+
+  for (;;) {
+    cell = &q->cells[pos & q->mask];
+    sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    diff = (ptrdiff_t)sequence - (ptrdiff_t)(pos + 1);
+
+    if (diff == 0) {
+      // Cell is filled, try to claim the position.
+      if (__atomic_compare_exchange_n(&q->dequeue_pos, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    } else if (diff < 0) {
+      // Producer did not fill the cell yet.
+      return MPQ_ERROR_QUEUE_EMPTY;
+    } else {
+      // Other consumer claimed the position, catch up.
+      pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  *value = cell->value;
+  // Free the cell for producer from the next lap.
+  __atomic_store_n(&cell->sequence, pos + q->mask + 1, __ATOMIC_RELEASE);
+
+  return MPQ_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *mpq_strerror(mpq_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= MPQ_ERROR_LEN) || (error >= MPQ_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return MPQ_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Rounds requested capacity up to the power of two.
+ */
+mpq_error _count_capacity(size_t requested, size_t *capacity) {
+  size_t power = 2;
+
+  while (power < requested) {
+    if (_is_overflow_size_t_multi(power, 2))
+      return MPQ_ERROR_OVERFLOW;
+
+    power *= 2;
+  }
+
+  *capacity = power;
+
+  return MPQ_SUCCESS;
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, MPQ_SIZE_T_MAX);
+}
@@ -0,0 +1,412 @@
+/* Run-length encoded list. Consecutive equal values are stored once, with */
+/*  the number of their repetitions.                                      */
+
+/* Status codes, labels and flags tend to repeat in long runs. This list
+ * stores each run as:
+ * - Run's value.
+ * - Run's end, i.e. prefix count of elements in this and all previous runs.
+ *     Index is mapped to run by binary search over ends.
+ * Values and ends are kept in two arrays, so the search touches ends only.
+ * Appending a value equal to the last one, or inserting it next to an equal
+ * one, extends existing run instead of creating new one.
+ */
+
+/* Notes:
+ * - `get` is O(log runs), not O(1). Sequential readers should iterate over
+ *     runs with rle_get_run, or expand the list into an array.
+ * - Insert in the middle has to increment ends of all following runs,
+ *     it is O(runs), but still does not depend on number of elements.
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "rle_list.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define RLE_MIN_CAPACITY 8
+
+struct rle_def {
+  /* Number of elements.*/
+  size_t length;
+
+  /* Value of each run. */
+  RLE_VALUE_TYPE *values;
+
+  /* Index after the last element of each run. */
+  size_t *ends;
+
+  size_t runs_length;
+  size_t runs_capacity;
+};
+
+static size_t _find_run(rle_ptr l, size_t i);
+static size_t _run_start(rle_ptr l, size_t run_i);
+static rle_error _insert_runs(rle_ptr l, size_t run_i, size_t runs_amount);
+static void _extend_runs(rle_ptr l, size_t run_i, size_t elements_amount);
+static rle_error _reserve_runs(rle_ptr l, size_t runs_length);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const RLE_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Index too big",
+};
+
+static const size_t RLE_ERROR_STRINGS_LEN =
+    sizeof(RLE_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates run-length encoded list's instance. No memory for runs is
+ *  allocated until the first append.
+ */
+rle_error rle_create(rle_ptr *l) {
+  rle_ptr l_local;
+
+  l_local = malloc(sizeof(struct rle_def));
+  if (!l_local)
+    return RLE_ERROR_OUT_OF_MEMORY;
+
+  l_local->length = 0;
+  l_local->values = NULL;
+  l_local->ends = NULL;
+  l_local->runs_length = 0;
+  l_local->runs_capacity = 0;
+
+  *l = l_local;
+
+  return RLE_SUCCESS;
+}
+
+/* Frees resouces allocated for list's instance.
+ */
+rle_error rle_destroy(rle_ptr l) {
+  free(l->values);
+  free(l->ends);
+  free(l);
+
+  return RLE_SUCCESS;
+}
+
+/* Returns list's length, i.e. number of elements, not runs.
+ * Does not return error, to be usable in for loop (see arl_length).
+ */
+size_t rle_length(rle_ptr l) { return l->length; }
+
+/* Returns number of runs.
+ */
+size_t rle_runs_amount(rle_ptr l) { return l->runs_length; }
+
+/* Returns number of bytes allocated for list's instance.
+ */
+size_t rle_memory_usage(rle_ptr l) {
+  return sizeof(struct rle_def) +
+         l->runs_capacity * (sizeof(RLE_VALUE_TYPE) + sizeof(size_t));
+}
+
+/* Gets value under the index.
+ */
+rle_error rle_get(rle_ptr l, size_t i, RLE_VALUE_TYPE *value) {
+  if (i >= l->length)
+    return RLE_ERROR_INDEX_TOO_BIG;
+
+  *value = l->values[_find_run(l, i)];
+
+  return RLE_SUCCESS;
+}
+
+/* Gets run's value and number of its elements.
+ */
+rle_error rle_get_run(rle_ptr l, size_t run_i, RLE_VALUE_TYPE *value,
+                      size_t *run_length) {
+  if (run_i >= l->runs_length)
+    return RLE_ERROR_INDEX_TOO_BIG;
+
+  *value = l->values[run_i];
+  *run_length = l->ends[run_i] - _run_start(l, run_i);
+
+  return RLE_SUCCESS;
+}
+
+/* Copies `elements_amount` elements starting with index `start_i` into the
+ *  slice. Only the first run is searched, the rest is read in order.
+ */
+rle_error rle_slice(rle_ptr l, size_t start_i, size_t elements_amount,
+                    RLE_VALUE_TYPE slice[]) {
+  size_t run_i, k;
+
+  if (elements_amount == 0)
+    return RLE_SUCCESS;
+
+  if (start_i >= l->length)
+    return RLE_ERROR_INDEX_TOO_BIG;
+
+  if (elements_amount > l->length - start_i)
+    return RLE_ERROR_INVALID_ARGS;
+
+  run_i = _find_run(l, start_i);
+
+  for (k = 0; k < elements_amount; k++) {
+    if (start_i + k == l->ends[run_i])
+      run_i++;
+
+    slice[k] = l->values[run_i];
+  }
+
+  return RLE_SUCCESS;
+}
+
+/* Expands the whole list into contiguous array, which has to have place for
+ *  rle_length elements.
+ */
+rle_error rle_expand(rle_ptr l, RLE_VALUE_TYPE values[]) {
+  size_t run_i, k;
+
+  for (run_i = 0, k = 0; run_i < l->runs_length; run_i++) {
+    for (; k < l->ends[run_i]; k++) {
+      values[k] = l->values[run_i];
+    }
+  }
+
+  return RLE_SUCCESS;
+}
+
+/* Appends one element to the list's end. Extends the last run if value is
+ *  equal to its value.
+ */
+rle_error rle_append(rle_ptr l, RLE_VALUE_TYPE value) {
+  return rle_append_run(l, value, 1);
+}
+
+/* Appends `run_length` copies of the value.
+ */
+rle_error rle_append_run(rle_ptr l, RLE_VALUE_TYPE value, size_t run_length) {
+  rle_error err;
+
+  if (run_length == 0)
+    return RLE_ERROR_INVALID_ARGS;
+
+  if (_is_overflow_size_t_add(l->length, run_length))
+    return RLE_ERROR_OVERFLOW;
+
+  if (l->runs_length &&
+      RLE_VALUE_EQUAL(l->values[l->runs_length - 1], value)) {
+    _extend_runs(l, l->runs_length - 1, run_length);
+    return RLE_SUCCESS;
+  }
+
+  err = _insert_runs(l, l->runs_length, 1);
+  if (err)
+    return err;
+
+  l->values[l->runs_length - 1] = value;
+  l->ends[l->runs_length - 1] = l->length;
+  _extend_runs(l, l->runs_length - 1, run_length);
+
+  return RLE_SUCCESS;
+}
+
+/* Insert one element under the index.
+ * If index bigger than list's length, appends the value.
+ * Value equal to a neighbour extends neighbour's run, otherwise run under
+ *  the index is split.
+ */
+rle_error rle_insert(rle_ptr l, size_t i, RLE_VALUE_TYPE value) {
+  size_t run_i, start;
+  rle_error err;
+
+  if (i >= l->length)
+    return rle_append(l, value);
+
+  if (_is_overflow_size_t_add(l->length, 1))
+    return RLE_ERROR_OVERFLOW;
+
+  run_i = _find_run(l, i);
+  start = _run_start(l, run_i);
+
+  if (RLE_VALUE_EQUAL(l->values[run_i], value)) {
+    _extend_runs(l, run_i, 1);
+    return RLE_SUCCESS;
+  }
+
+  if (i == start && run_i && RLE_VALUE_EQUAL(l->values[run_i - 1], value)) {
+    _extend_runs(l, run_i - 1, 1);
+    return RLE_SUCCESS;
+  }
+
+  if (i == start) {
+    // New run in front of the run under the index.
+    err = _insert_runs(l, run_i, 1);
+    if (err)
+      return err;
+  } else {
+    // Run under the index is split in two, new run goes between them.
+    err = _insert_runs(l, run_i, 2);
+    if (err)
+      return err;
+
+    l->ends[run_i] = i;
+    run_i++;
+  }
+
+  l->values[run_i] = value;
+  l->ends[run_i] = i;
+  _extend_runs(l, run_i, 1);
+
+  return RLE_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *rle_strerror(rle_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= RLE_ERROR_LEN) || (error >= RLE_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return RLE_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Returns index of the run holding element under the index, i.e. the first
+ *  run ending after it. Index has to be smaller than list's length.
+ */
+size_t _find_run(rle_ptr l, size_t i) {
+  size_t low = 0, high = l->runs_length - 1, middle;
+
+  while (low < high) {
+    middle = low + (high - low) / 2;
+
+    if (l->ends[middle] > i)
+      high = middle;
+    else
+      low = middle + 1;
+  }
+
+  return low;
+}
+
+/* Returns index of run's first element.
+ */
+size_t _run_start(rle_ptr l, size_t run_i) {
+  return run_i ? l->ends[run_i - 1] : 0;
+}
+
+/* Makes place for `runs_amount` runs in front of the run `run_i`, runs after
+ *  it are moved. Moved runs' copies stay at the place, so the first of them
+ *  keeps run's value and end.
+ */
+rle_error _insert_runs(rle_ptr l, size_t run_i, size_t runs_amount) {
+  rle_error err;
+
+  if (_is_overflow_size_t_add(l->runs_length, runs_amount))
+    return RLE_ERROR_OVERFLOW;
+
+  err = _reserve_runs(l, l->runs_length + runs_amount);
+  if (err)
+    return err;
+
+  memmove(&l->values[run_i + runs_amount], &l->values[run_i],
+          (l->runs_length - run_i) * sizeof(RLE_VALUE_TYPE));
+  memmove(&l->ends[run_i + runs_amount], &l->ends[run_i],
+          (l->runs_length - run_i) * sizeof(size_t));
+
+  l->runs_length += runs_amount;
+
+  return RLE_SUCCESS;
+}
+
+/* Adds elements to the run, ends of all following runs are shifted.
+ */
+void _extend_runs(rle_ptr l, size_t run_i, size_t elements_amount) {
+  for (; run_i < l->runs_length; run_i++) {
+    l->ends[run_i] += elements_amount;
+  }
+
+  l->length += elements_amount;
+}
+
+/* Makes sure runs' arrays have place for `runs_length` runs, doubling
+ *  capacity.
+ */
+rle_error _reserve_runs(rle_ptr l, size_t runs_length) {
+  size_t new_capacity = l->runs_capacity ? l->runs_capacity : RLE_MIN_CAPACITY;
+  void *p;
+
+  if (runs_length <= l->runs_capacity)
+    return RLE_SUCCESS;
+
+  while (new_capacity < runs_length) {
+    if (_is_overflow_size_t_multi(new_capacity, 2))
+      return RLE_ERROR_OVERFLOW;
+    new_capacity *= 2;
+  }
+
+  if (_is_overflow_size_t_multi(new_capacity, sizeof(RLE_VALUE_TYPE)) ||
+      _is_overflow_size_t_multi(new_capacity, sizeof(size_t)))
+    return RLE_ERROR_OVERFLOW;
+
+  // Capacity is updated only when both arrays are reallocated, the bigger
+  //  one stays on failure.
+  p = realloc(l->values, new_capacity * sizeof(RLE_VALUE_TYPE));
+  if (!p)
+    return RLE_ERROR_OUT_OF_MEMORY;
+  l->values = p;
+
+  p = realloc(l->ends, new_capacity * sizeof(size_t));
+  if (!p)
+    return RLE_ERROR_OUT_OF_MEMORY;
+  l->ends = p;
+
+  l->runs_capacity = new_capacity;
+
+  return RLE_SUCCESS;
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, RLE_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, RLE_SIZE_T_MAX);
+}
@@ -0,0 +1,410 @@
+/* Concurrent append only segmented list. Storage is a sequence of segments, */
+/*  each twice as big as previous one. Segments are never moved.              */
+
+/* Array list's `realloc` moves every element, so readers of arl_list need to
+ * lock against writers. This list never moves elements:
+ * - Segment `k` holds `first_segment_capacity * 2^k` elements. Index is
+ *     mapped to segment and offset by few bit operations.
+ * - Writers reserve slots by atomic fetch and add on `reserved` counter, so
+ *     appending threads do not wait for each other while writing values.
+ * - Segment is allocated by the first writer which needs it. Writers racing
+ *     for the same segment publish it by compare and swap, loosers free
+ *     their allocation.
+ * - Every slot has ready flag, stored in segment after the values. Writer
+ *     sets the flag when value is written, then moves `committed` counter
+ *     over all ready slots it can see. Everything below `committed` is
+ *     written, so readers index without any lock. Returned pointers stay
+ *     valid till destroy.
+ */
+
+/* Notes:
+ * - Writers never wait for each other. If writer is preempted before setting
+ *     it's flag, `committed` stops there and the first writer finishing after
+ *     it moves `committed` over slots finished meanwhile.
+ * - If segment's allocation fails or `reserved` counter wraps, reserved
+ *     slots are never published and list is marked as failed. New appends
+ *     are refused, already published elements stay readable.
+ * - Atomics are done by GCC's `__atomic` builtins (supported by clang too),
+ *     so the list still compiles as C99.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "sgl_list.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define SGL_CACHE_LINE_SIZE 64
+#define SGL_SEGMENTS_MAX (sizeof(size_t) * CHAR_BIT)
+
+/* Counters live on separate cache lines, readers polling `committed` do not
+ * slow down writers reserving slots.
+ */
+struct sgl_def {
+  char _pad0[SGL_CACHE_LINE_SIZE];
+
+  /* Number of reserved slots. */
+  size_t reserved;
+  char _pad1[SGL_CACHE_LINE_SIZE - sizeof(size_t)];
+
+  /* Number of published elements (list's length). */
+  size_t committed;
+  char _pad2[SGL_CACHE_LINE_SIZE - sizeof(size_t)];
+
+  /* Set when segment's allocation failed. */
+  int failed;
+
+  /* First segment's capacity is `1 << first_segment_shift`. */
+  size_t first_segment_shift;
+
+  /* Storage. Each segment is followed by it's slots' ready flags. */
+  SGL_VALUE_TYPE *segments[SGL_SEGMENTS_MAX];
+};
+
+static void _locate(sgl_ptr l, size_t i, size_t *segment_i, size_t *offset);
+static size_t _segment_capacity(sgl_ptr l, size_t segment_i);
+static sgl_error _get_segment(sgl_ptr l, size_t segment_i,
+                              SGL_VALUE_TYPE **segment);
+static unsigned char *_get_flags(sgl_ptr l, size_t segment_i,
+                                 SGL_VALUE_TYPE *segment);
+static void _publish(sgl_ptr l);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const SGL_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Index too big",
+    // 5
+    "List failed to allocate memory before, appending is disallowed",
+};
+
+static const size_t SGL_ERROR_STRINGS_LEN =
+    sizeof(SGL_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates segmented list's instance.
+ * First segment's capacity is rounded up to the power of two. No memory for
+ *  elements is allocated until first append.
+ */
+sgl_error sgl_create(sgl_ptr *l, size_t first_segment_capacity) {
+  size_t shift = 0, i;
+  sgl_ptr l_local;
+
+  if (first_segment_capacity == 0)
+    return SGL_ERROR_INVALID_ARGS;
+
+  while (((size_t)1 << shift) < first_segment_capacity) {
+    if (shift + 1 >= SGL_SEGMENTS_MAX)
+      return SGL_ERROR_OVERFLOW;
+    shift++;
+  }
+
+  l_local = malloc(sizeof(struct sgl_def));
+  if (!l_local)
+    return SGL_ERROR_OUT_OF_MEMORY;
+
+  l_local->reserved = 0;
+  l_local->committed = 0;
+  l_local->failed = 0;
+  l_local->first_segment_shift = shift;
+
+  for (i = 0; i < SGL_SEGMENTS_MAX; i++) {
+    l_local->segments[i] = NULL;
+  }
+
+  *l = l_local;
+
+  return SGL_SUCCESS;
+}
+
+/* Frees resouces allocated for list's instance.
+ * No thread can use the list while it's destroyed.
+ */
+sgl_error sgl_destroy(sgl_ptr l) {
+  size_t i;
+
+  for (i = 0; i < SGL_SEGMENTS_MAX; i++) {
+    free(l->segments[i]);
+  }
+
+  free(l);
+
+  return SGL_SUCCESS;
+}
+
+/* Returns list's length, number of published elements.
+ *
+ * !!!WARNING!!!
+ * THIS FUNCTION DO NOT RETURN ERROR!!!
+ * !!!WARNING!!!
+ *
+ * Every index smaller than returned length is safe to read.
+ */
+size_t sgl_length(sgl_ptr l) {
+  return __atomic_load_n(&l->committed, __ATOMIC_ACQUIRE);
+}
+
+/* Gets value under the index.
+ */
+sgl_error sgl_get(sgl_ptr l, size_t i, SGL_VALUE_TYPE *value) {
+  SGL_VALUE_TYPE *p;
+  sgl_error err;
+
+  err = sgl_get_ptr(l, i, &p);
+  if (err)
+    return err;
+
+  *value = *p;
+
+  return SGL_SUCCESS;
+}
+
+/* Gets pointer to the element under the index.
+ * Pointer stays valid until the list is destroyed.
+ */
+sgl_error sgl_get_ptr(sgl_ptr l, size_t i, SGL_VALUE_TYPE **value) {
+  size_t segment_i, offset;
+  SGL_VALUE_TYPE *segment;
+
+  if (i >= sgl_length(l))
+    return SGL_ERROR_INDEX_TOO_BIG;
+
+  _locate(l, i, &segment_i, &offset);
+
+  segment = __atomic_load_n(&l->segments[segment_i], __ATOMIC_ACQUIRE);
+
+  *value = segment + offset;
+
+  return SGL_SUCCESS;
+}
+
+/* Appends one element to the list's end.
+ */
+sgl_error sgl_append(sgl_ptr l, SGL_VALUE_TYPE value) {
+  return sgl_append_multi(l, 1, &value);
+}
+
+/* Appends multiple elements to the list's end. Values are kept next to each
+ *  other, other writers' values do not interleave with them.
+ */
+sgl_error sgl_append_multi(sgl_ptr l, size_t v_len, SGL_VALUE_TYPE values[]) {
+  size_t start_i, i, k, segment_i, offset, amount, copied = 0;
+  SGL_VALUE_TYPE *segment;
+  unsigned char *flags;
+  sgl_error err;
+
+  if (v_len == 0)
+    return SGL_SUCCESS;
+
+  if (__atomic_load_n(&l->failed, __ATOMIC_ACQUIRE))
+    return SGL_ERROR_LIST_FAILED;
+
+  start_i = __atomic_fetch_add(&l->reserved, v_len, __ATOMIC_RELAXED);
+
+  // Wrapped counter would hand out slots twice, so it is checked after the
+  // reservation, appenders never retry.
+  if (_is_overflow_size_t_add(start_i, v_len)) {
+    __atomic_store_n(&l->failed, 1, __ATOMIC_RELEASE);
+    return SGL_ERROR_OVERFLOW;
+  }
+
+  while (copied < v_len) {
+    i = start_i + copied;
+
+    _locate(l, i, &segment_i, &offset);
+
+    err = _get_segment(l, segment_i, &segment);
+    if (err) {
+      // Slots after this one would never be published.
+      __atomic_store_n(&l->failed, 1, __ATOMIC_RELEASE);
+      return err;
+    }
+
+    amount = _segment_capacity(l, segment_i) - offset;
+    if (amount > v_len - copied)
+      amount = v_len - copied;
+
+    memcpy(segment + offset, values + copied, amount * SGL_VALUE_SIZE);
+
+    flags = _get_flags(l, segment_i, segment) + offset;
+    for (k = 0; k < amount; k++) {
+      __atomic_store_n(&flags[k], 1, __ATOMIC_RELEASE);
+    }
+
+    copied += amount;
+  }
+
+  _publish(l);
+
+  return SGL_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *sgl_strerror(sgl_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= SGL_ERROR_LEN) || (error >= SGL_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return SGL_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Maps index to segment and offset inside of the segment.
+ * Segment `k` starts at index `first_segment_capacity * (2^k - 1)`.
+ */
+void _locate(sgl_ptr l, size_t i, size_t *segment_i, size_t *offset) {
+  size_t block = (i >> l->first_segment_shift) + 1;
+  size_t k = 0;
+
+  // Segment is position of block's highest bit.
+#if defined(__GNUC__)
+  k = sizeof(unsigned long long) * CHAR_BIT - 1 -
+      __builtin_clzll((unsigned long long)block);
+#else
+  while (block >>= 1)
+    k++;
+#endif
+
+  *segment_i = k;
+  *offset = i - ((((size_t)1 << k) - 1) << l->first_segment_shift);
+}
+
+size_t _segment_capacity(sgl_ptr l, size_t segment_i) {
+  return (size_t)1 << (l->first_segment_shift + segment_i);
+}
+
+/* Returns segment, allocates it if it does not exist yet.
+ */
+sgl_error _get_segment(sgl_ptr l, size_t segment_i, SGL_VALUE_TYPE **segment) {
+  SGL_VALUE_TYPE *expected = NULL;
+  SGL_VALUE_TYPE *p;
+  size_t capacity;
+
+  p = __atomic_load_n(&l->segments[segment_i], __ATOMIC_ACQUIRE);
+  if (p) {
+    *segment = p;
+    return SGL_SUCCESS;
+  }
+
+  if (l->first_segment_shift + segment_i >= SGL_SEGMENTS_MAX)
+    return SGL_ERROR_OVERFLOW;
+
+  capacity = _segment_capacity(l, segment_i);
+
+  // One byte of ready flag per each value.
+  if (_is_overflow_size_t_multi(capacity, SGL_VALUE_SIZE + 1))
+    return SGL_ERROR_OVERFLOW;
+
+  p = malloc(capacity * (SGL_VALUE_SIZE + 1));
+  if (!p)
+    return SGL_ERROR_OUT_OF_MEMORY;
+
+  memset(_get_flags(l, segment_i, p), 0, capacity);
+
+  if (!__atomic_compare_exchange_n(&l->segments[segment_i], &expected, p,
+                                   false, __ATOMIC_ACQ_REL,
+                                   __ATOMIC_ACQUIRE)) {
+    // Other writer was faster.
+    free(p);
+    p = expected;
+  }
+
+  *segment = p;
+
+  return SGL_SUCCESS;
+}
+
+unsigned char *_get_flags(sgl_ptr l, size_t segment_i,
+                          SGL_VALUE_TYPE *segment) {
+  return (unsigned char *)(segment + _segment_capacity(l, segment_i));
+}
+
+/* Moves `committed` over all slots which are ready. Many writers may publish
+ *  at the same time, each of them moves `committed` as far as it can see.
+ */
+void _publish(sgl_ptr l) {
+  size_t committed, end_i, reserved, segment_i, offset;
+  SGL_VALUE_TYPE *segment;
+
+  committed = __atomic_load_n(&l->committed, __ATOMIC_ACQUIRE);
+
+  for (;;) {
+    reserved = __atomic_load_n(&l->reserved, __ATOMIC_ACQUIRE);
+    end_i = committed;
+
+    while (end_i < reserved) {
+      _locate(l, end_i, &segment_i, &offset);
+
+      segment = __atomic_load_n(&l->segments[segment_i], __ATOMIC_ACQUIRE);
+      if (!segment ||
+          !__atomic_load_n(_get_flags(l, segment_i, segment) + offset,
+                           __ATOMIC_ACQUIRE))
+        break;
+
+      end_i++;
+    }
+
+    if (end_i == committed)
+      return;
+
+    // On failure `committed` holds the current value, other writer moved it.
+    if (__atomic_compare_exchange_n(&l->committed, &committed, end_i, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      committed = end_i;
+  }
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, SGL_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, SGL_SIZE_T_MAX);
+}
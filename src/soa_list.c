@@ -0,0 +1,318 @@
+/* Struct of arrays list. Rows are structures, each field is kept in it's */
+/*  own contiguous array.                                                */
+
+/* Scans over records usually read one or two of their fields. With array of
+ * structures every other field is pulled into cache with them, this list
+ * keeps:
+ * - One array (column) per field, all with the same capacity.
+ * - Row operations (set, insert, pop) writing or moving all columns in one
+ *     pass over fields.
+ * - Field operations reading and writing one column only. Field's view is
+ *     a plain array, ready for tight loops.
+ * Fields are described by SOA_FIELDS X macro, every per field function and
+ * loop is expanded from it.
+ */
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "soa_list.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define SOA_MIN_CAPACITY 8
+
+#define SOA_COLUMN_MEMBER(type, name) type *name;
+
+struct soa_def {
+  /* Number of rows.*/
+  size_t length;
+
+  /* Number of rows each column has place for. */
+  size_t capacity;
+
+  /* Array per field. */
+  struct {
+    SOA_FIELDS(SOA_COLUMN_MEMBER)
+  } columns;
+};
+
+static soa_error _reserve(soa_ptr l, size_t length);
+static void _free_columns(soa_ptr l);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const SOA_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Index too big",
+};
+
+static const size_t SOA_ERROR_STRINGS_LEN =
+    sizeof(SOA_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates struct of arrays list's instance, each column has place for
+ *  `default_capacity` rows.
+ */
+soa_error soa_create(soa_ptr *l, size_t default_capacity) {
+  soa_ptr l_local;
+  soa_error err;
+
+  l_local = malloc(sizeof(struct soa_def));
+  if (!l_local)
+    return SOA_ERROR_OUT_OF_MEMORY;
+
+#define SOA_COLUMN_INIT(type, name) l_local->columns.name = NULL;
+  SOA_FIELDS(SOA_COLUMN_INIT)
+#undef SOA_COLUMN_INIT
+
+  l_local->length = 0;
+  l_local->capacity = 0;
+
+  err = _reserve(l_local, default_capacity);
+  if (err)
+    goto CLEANUP_L_LOCAL;
+
+  *l = l_local;
+
+  return SOA_SUCCESS;
+
+CLEANUP_L_LOCAL:
+  _free_columns(l_local);
+  free(l_local);
+  return err;
+}
+
+/* Frees resouces allocated for list's instance.
+ */
+soa_error soa_destroy(soa_ptr l) {
+  _free_columns(l);
+  free(l);
+
+  return SOA_SUCCESS;
+}
+
+/* Returns list's length, i.e. number of rows.
+ * Does not return error, to be usable in for loop (see arl_length).
+ */
+size_t soa_length(soa_ptr l) { return l->length; }
+
+/* Gets row under the index, gathered from all columns.
+ */
+soa_error soa_get(soa_ptr l, size_t i, struct soa_row *row) {
+  if (i >= l->length)
+    return SOA_ERROR_INDEX_TOO_BIG;
+
+#define SOA_COLUMN_GET(type, name) row->name = l->columns.name[i];
+  SOA_FIELDS(SOA_COLUMN_GET)
+#undef SOA_COLUMN_GET
+
+  return SOA_SUCCESS;
+}
+
+/* Sets row under the index, scattered into all columns.
+ * Index has to be smaller than list's length.
+ */
+soa_error soa_set(soa_ptr l, size_t i, const struct soa_row *row) {
+  if (i >= l->length)
+    return SOA_ERROR_INDEX_TOO_BIG;
+
+#define SOA_COLUMN_SET(type, name) l->columns.name[i] = row->name;
+  SOA_FIELDS(SOA_COLUMN_SET)
+#undef SOA_COLUMN_SET
+
+  return SOA_SUCCESS;
+}
+
+/* Insert one row under the index.
+ * If index bigger than list's length, appends the row.
+ * Each column is moved and written in the same pass over fields.
+ */
+soa_error soa_insert(soa_ptr l, size_t i, const struct soa_row *row) {
+  size_t rows_to_move;
+  soa_error err;
+
+  if (_is_overflow_size_t_add(l->length, 1))
+    return SOA_ERROR_OVERFLOW;
+
+  err = _reserve(l, l->length + 1);
+  if (err)
+    return err;
+
+  if (i > l->length)
+    i = l->length;
+
+  rows_to_move = l->length - i;
+
+#define SOA_COLUMN_INSERT(type, name)                                          \
+  memmove(&l->columns.name[i + 1], &l->columns.name[i],                        \
+          rows_to_move * sizeof(type));                                        \
+  l->columns.name[i] = row->name;
+  SOA_FIELDS(SOA_COLUMN_INSERT)
+#undef SOA_COLUMN_INSERT
+
+  l->length++;
+
+  return SOA_SUCCESS;
+}
+
+/* Appends one row to the list's end.
+ */
+soa_error soa_append(soa_ptr l, const struct soa_row *row) {
+  return soa_insert(l, l->length, row);
+}
+
+/* Removes row under the index, and writes it into `row` if not NULL.
+ */
+soa_error soa_pop(soa_ptr l, size_t i, struct soa_row *row) {
+  size_t rows_to_move;
+
+  if (i >= l->length)
+    return SOA_ERROR_INDEX_TOO_BIG;
+
+  if (row)
+    soa_get(l, i, row);
+
+  rows_to_move = l->length - i - 1;
+
+#define SOA_COLUMN_POP(type, name)                                             \
+  memmove(&l->columns.name[i], &l->columns.name[i + 1],                        \
+          rows_to_move * sizeof(type));
+  SOA_FIELDS(SOA_COLUMN_POP)
+#undef SOA_COLUMN_POP
+
+  l->length--;
+
+  return SOA_SUCCESS;
+}
+
+/* Removes all rows, capacity is kept.
+ */
+soa_error soa_clear(soa_ptr l) {
+  l->length = 0;
+
+  return SOA_SUCCESS;
+}
+
+/*******************************************************************************
+ *    FIELD API
+ ******************************************************************************/
+#define SOA_FIELD_DEFINITIONS(type, name)                                      \
+  soa_error soa_get_##name(soa_ptr l, size_t i, type *value) {                 \
+    if (i >= l->length)                                                        \
+      return SOA_ERROR_INDEX_TOO_BIG;                                          \
+                                                                               \
+    *value = l->columns.name[i];                                               \
+                                                                               \
+    return SOA_SUCCESS;                                                        \
+  }                                                                            \
+                                                                               \
+  soa_error soa_set_##name(soa_ptr l, size_t i, type value) {                  \
+    if (i >= l->length)                                                        \
+      return SOA_ERROR_INDEX_TOO_BIG;                                          \
+                                                                               \
+    l->columns.name[i] = value;                                                \
+                                                                               \
+    return SOA_SUCCESS;                                                        \
+  }                                                                            \
+                                                                               \
+  const type *soa_view_##name(soa_ptr l) { return l->columns.name; }
+
+SOA_FIELDS(SOA_FIELD_DEFINITIONS)
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *soa_strerror(soa_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= SOA_ERROR_LEN) || (error >= SOA_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return SOA_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Makes sure all columns have place for `length` rows, doubling capacity.
+ * Capacity is updated only when all columns are reallocated, the bigger
+ *  ones stay on failure.
+ */
+soa_error _reserve(soa_ptr l, size_t length) {
+  size_t new_capacity = l->capacity ? l->capacity : SOA_MIN_CAPACITY;
+  void *p;
+
+  if (length <= l->capacity)
+    return SOA_SUCCESS;
+
+  while (new_capacity < length) {
+    if (_is_overflow_size_t_multi(new_capacity, 2))
+      return SOA_ERROR_OVERFLOW;
+    new_capacity *= 2;
+  }
+
+#define SOA_COLUMN_RESERVE(type, name)                                         \
+  if (_is_overflow_size_t_multi(new_capacity, sizeof(type)))                   \
+    return SOA_ERROR_OVERFLOW;                                                 \
+  p = realloc(l->columns.name, new_capacity * sizeof(type));                   \
+  if (!p)                                                                      \
+    return SOA_ERROR_OUT_OF_MEMORY;                                            \
+  l->columns.name = p;
+  SOA_FIELDS(SOA_COLUMN_RESERVE)
+#undef SOA_COLUMN_RESERVE
+
+  l->capacity = new_capacity;
+
+  return SOA_SUCCESS;
+}
+
+void _free_columns(soa_ptr l) {
+#define SOA_COLUMN_FREE(type, name) free(l->columns.name);
+  SOA_FIELDS(SOA_COLUMN_FREE)
+#undef SOA_COLUMN_FREE
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, SOA_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, SOA_SIZE_T_MAX);
+}
@@ -0,0 +1,846 @@
+/* Thread safe array list implementation. Array list is described here: */
+/*   https://en.wikipedia.org/wiki/Dynamic_array                        */
+
+/* List's logic is the same as in arl_list. What is added is synchronization:
+ * - Every operation takes internal reader-writer lock, so many readers
+ *     (`tsl_get`, `tsl_slice`) proceed in parallel and writers are exclusive.
+ * - Batch operations (`*_multi`) take the lock once for all the values,
+ *     so callers do not need to hold their own mutex across loops.
+ * - Writers bump sequence counter before and after modifying the list
+ *     (seqlock). `tsl_get_optimistic` reads without taking the lock and
+ *     retries if any writer was active meanwhile.
+ * - `tsl_snapshot_acquire` pins current array and length. Writer which finds
+ *     array pinned copies it before the first modification (copy on write)
+ *     and works on the copy. So readers get consistent array without locking
+ *     and without stalling writers, each snapshot costs at most one copy.
+ */
+
+/* Notes:
+ * - Lock free readers (optimistic gets and snapshots) may use the array while
+ *     writer replaces it. To keep that memory valid, growing does not use
+ *     realloc. New array is allocated, elements are copied and old array is
+ *     retired. Retired arrays are freed by epoch based reclamation: reader
+ *     announces list's epoch in it's slot before loading the array, writer
+ *     bumps the epoch after replacing the array. Array retired in epoch `e`
+ *     is freed once every announced epoch is bigger than `e`.
+ * - Element copy done by optimistic reader races with writers by design,
+ *     the value is discarded if sequence changed. That copy is excluded from
+ *     ThreadSanitizer instrumentation.
+ * - Atomics are done by GCC's `__atomic` builtins (supported by clang too),
+ *     so the list still compiles as C99.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "tsl_list.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define TSL_OPTIMISTIC_RETRIES 16
+#define TSL_CACHE_LINE_SIZE 64
+
+/* Maximum number of threads reading without the lock at the same time. */
+#ifndef TSL_READERS_MAX
+#define TSL_READERS_MAX 64
+#endif
+
+#if defined(__GNUC__)
+#define TSL_NO_SANITIZE_THREAD __attribute__((no_sanitize_thread, noinline))
+#else
+#define TSL_NO_SANITIZE_THREAD
+#endif
+
+/* GCC's ThreadSanitizer rejects fences. Fences order only the racy copy,
+ * which is not instrumented, so dropping them does not change what is checked.
+ */
+#if defined(__SANITIZE_THREAD__)
+#define _sequence_fence(order)
+#else
+#define _sequence_fence(order) __atomic_thread_fence(order)
+#endif
+
+struct tsl_retired {
+  void *array;
+  size_t epoch;
+  struct tsl_retired *next;
+};
+
+/* Readers' slots live on separate cache lines, so readers entering and
+ * leaving do not invalidate each other's lines.
+ */
+struct tsl_reader {
+  /* Announced epoch + 1, 0 stands for free slot. */
+  size_t epoch;
+  char _pad[TSL_CACHE_LINE_SIZE - sizeof(size_t)];
+};
+
+struct tsl_def {
+  /* Protects everything below. */
+  pthread_rwlock_t lock;
+
+  /* Odd while writer is modifying the list. */
+  size_t sequence;
+
+  /* Number of elements.*/
+  size_t length;
+
+  /* Maximum number of elements. */
+  size_t capacity;
+
+  /* Storage. */
+  TSL_VALUE_TYPE *array;
+
+  /* Set when array is used by a snapshot. */
+  int pinned;
+
+  /* Arrays replaced by writers, see notes. */
+  struct tsl_retired *retired;
+  size_t epoch;
+  struct tsl_reader readers[TSL_READERS_MAX];
+};
+
+static bool _is_i_too_big(tsl_ptr l, size_t i);
+static void _write_begin(tsl_ptr l);
+static void _write_end(tsl_ptr l);
+static void _set_length(tsl_ptr l, size_t length);
+static void _copy_racy(TSL_VALUE_TYPE *dest, TSL_VALUE_TYPE *array, size_t i);
+static tsl_error _grow_array_capacity(tsl_ptr l, size_t min_capacity);
+static tsl_error _prepare_write(tsl_ptr l);
+static tsl_error _replace_array(tsl_ptr l, size_t new_capacity);
+// Epoch utils
+static tsl_error _epoch_enter(tsl_ptr l, size_t *slot);
+static void _epoch_exit(tsl_ptr l, size_t slot);
+static void _reclaim(tsl_ptr l);
+static tsl_error _insert_multi(tsl_ptr l, size_t i, size_t v_len,
+                               TSL_VALUE_TYPE values[]);
+static tsl_error _pop_multi(tsl_ptr l, size_t i, size_t elements_amount,
+                            TSL_VALUE_TYPE holder[]);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+static bool _is_overflow_size_t_add(size_t a, size_t b);
+
+// Error utils
+static const char *const TSL_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Underflow",
+    // 4
+    "Not enough memory",
+    // 5
+    "Index too big",
+    // 6
+    "Popping empty list is disallowed",
+    // 7
+    "Unable to acquire list's lock",
+    // 8
+    "Too many lock free readers at the same time",
+};
+
+static const size_t TSL_ERROR_STRINGS_LEN =
+    sizeof(TSL_ERROR_STRINGS) / sizeof(char *);
+
+#define _read_lock(l)                                                          \
+  do {                                                                         \
+    if (pthread_rwlock_rdlock(&l->lock))                                       \
+      return TSL_ERROR_LOCK;                                                   \
+  } while (0)
+
+#define _write_lock(l)                                                         \
+  do {                                                                         \
+    if (pthread_rwlock_wrlock(&l->lock))                                       \
+      return TSL_ERROR_LOCK;                                                   \
+  } while (0)
+
+#define _unlock(l) pthread_rwlock_unlock(&l->lock)
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates thread safe array list's instance.
+ * Behaviour is undefined if `default_capacity` is equal 0.
+ */
+tsl_error tsl_create(tsl_ptr *l, size_t default_capacity) {
+  size_t i;
+
+  if (_is_overflow_size_t_multi(default_capacity, TSL_VALUE_SIZE))
+    return TSL_ERROR_OVERFLOW;
+
+  void *l_array = malloc(default_capacity * TSL_VALUE_SIZE);
+
+  if (!l_array)
+    goto ERROR_OOM;
+
+  tsl_ptr l_local = malloc(sizeof(struct tsl_def));
+
+  if (!l_local)
+    goto CLEANUP_L_LOCAL_OOM;
+
+  if (pthread_rwlock_init(&l_local->lock, NULL))
+    goto CLEANUP_LOCK_ERROR;
+
+  l_local->array = (TSL_VALUE_TYPE *)l_array;
+  l_local->capacity = default_capacity;
+  l_local->length = 0;
+  l_local->sequence = 0;
+  l_local->pinned = 0;
+  l_local->retired = NULL;
+  l_local->epoch = 0;
+
+  for (i = 0; i < TSL_READERS_MAX; i++) {
+    l_local->readers[i].epoch = 0;
+  }
+
+  *l = l_local;
+
+  return TSL_SUCCESS;
+
+CLEANUP_LOCK_ERROR:
+  free(l_local);
+  free(l_array);
+  return TSL_ERROR_LOCK;
+CLEANUP_L_LOCAL_OOM:
+  free(l_array);
+ERROR_OOM:
+  return TSL_ERROR_OUT_OF_MEMORY;
+}
+
+/* Frees resouces allocated for list's instance.
+ * No thread can use the list while it's destroyed.
+ */
+tsl_error tsl_destroy(tsl_ptr l) {
+  struct tsl_retired *retired;
+
+  while (l->retired) {
+    retired = l->retired;
+    l->retired = retired->next;
+
+    free(retired->array);
+    free(retired);
+  }
+
+  pthread_rwlock_destroy(&l->lock);
+  free(l->array);
+  free(l);
+
+  return TSL_SUCCESS;
+}
+
+/* Returns list's length.
+ *
+ * !!!WARNING!!!
+ * THIS FUNCTION DO NOT RETURN ERROR!!!
+ * !!!WARNING!!!
+ *
+ * Does not take the lock. Length is one word written once per operation, so
+ *  reading it optimistically never needs a retry. While other threads are
+ *  modifying the list, the value may be outdated as soon as it's returned.
+ */
+size_t tsl_length(tsl_ptr l) {
+  return __atomic_load_n(&l->length, __ATOMIC_ACQUIRE);
+}
+
+/* Gets value under the index.
+ */
+tsl_error tsl_get(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value) {
+  tsl_error err = TSL_SUCCESS;
+
+  _read_lock(l);
+
+  if (_is_i_too_big(l, i))
+    err = TSL_ERROR_INDEX_TOO_BIG;
+  else
+    *value = l->array[i];
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Gets value under the index without taking the lock.
+ * If writers keep the list busy, falls back to `tsl_get`.
+ */
+tsl_error tsl_get_optimistic(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value) {
+  size_t start_sequence, length, capacity, attempt, slot;
+  TSL_VALUE_TYPE value_holder;
+  TSL_VALUE_TYPE *array;
+
+  if (_epoch_enter(l, &slot))
+    return tsl_get(l, i, value);
+
+  for (attempt = 0; attempt < TSL_OPTIMISTIC_RETRIES; attempt++) {
+    start_sequence = __atomic_load_n(&l->sequence, __ATOMIC_ACQUIRE);
+    if (start_sequence & 1)
+      continue;
+
+    // Capacity is loaded before array. Arrays only grow, so array is
+    //  at least as big as loaded capacity.
+    length = __atomic_load_n(&l->length, __ATOMIC_ACQUIRE);
+    capacity = __atomic_load_n(&l->capacity, __ATOMIC_ACQUIRE);
+    array = __atomic_load_n(&l->array, __ATOMIC_ACQUIRE);
+
+    if (i < length && i < capacity)
+      _copy_racy(&value_holder, array, i);
+
+    _sequence_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&l->sequence, __ATOMIC_RELAXED) != start_sequence)
+      continue;
+
+    _epoch_exit(l, slot);
+
+    if (i >= length)
+      return TSL_ERROR_INDEX_TOO_BIG;
+
+    *value = value_holder;
+
+    return TSL_SUCCESS;
+  }
+
+  _epoch_exit(l, slot);
+
+  return tsl_get(l, i, value);
+}
+
+/* Fills slice with `elements_amount` elements, starting from index start_i.
+ *  Unlike arl_slice, count is exclusive (see tsl_list.h). Start i and
+ *  elements amount have to respect list's length, otherwise error is
+ *  raised. Slice's length has to be at least elements amount, otherwise
+ *  behaviour is undefined.
+ */
+tsl_error tsl_slice(tsl_ptr l, size_t start_i, size_t elements_amount,
+                    TSL_VALUE_TYPE slice[]) {
+  tsl_error err = TSL_SUCCESS;
+
+  if (_is_overflow_size_t_add(start_i, elements_amount))
+    return TSL_ERROR_OVERFLOW;
+
+  _read_lock(l);
+
+  if (_is_i_too_big(l, start_i))
+    err = TSL_ERROR_INDEX_TOO_BIG;
+  else if (start_i + elements_amount > l->length)
+    err = TSL_ERROR_INVALID_ARGS;
+  else
+    memcpy(slice, l->array + start_i, elements_amount * TSL_VALUE_SIZE);
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Acquires consistent view of the list, without taking the lock.
+ * Waits only if a writer is modifying the list at the moment. Reading
+ *  snapshot's array is wait free. Snapshot has to be released by
+ *  `tsl_snapshot_release`.
+ */
+tsl_error tsl_snapshot_acquire(tsl_ptr l, struct tsl_snapshot *snapshot) {
+  size_t start_sequence;
+  tsl_error err;
+
+  err = _epoch_enter(l, &snapshot->slot);
+  if (err)
+    return err;
+
+  for (;;) {
+    start_sequence = __atomic_load_n(&l->sequence, __ATOMIC_ACQUIRE);
+    if (start_sequence & 1) {
+      sched_yield();
+      continue;
+    }
+
+    snapshot->array = (const TSL_VALUE_TYPE *)__atomic_load_n(&l->array,
+                                                             __ATOMIC_ACQUIRE);
+    snapshot->length = __atomic_load_n(&l->length, __ATOMIC_ACQUIRE);
+
+    // Writer which starts after this store copies the array, writer which
+    //  started before changes the sequence.
+    __atomic_store_n(&l->pinned, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&l->sequence, __ATOMIC_SEQ_CST) == start_sequence)
+      return TSL_SUCCESS;
+  }
+}
+
+/* Releases the snapshot. Snapshot's array cannot be used afterwards.
+ * If the lock is free, frees arrays which are not used by any reader.
+ */
+tsl_error tsl_snapshot_release(tsl_ptr l, struct tsl_snapshot *snapshot) {
+  _epoch_exit(l, snapshot->slot);
+
+  snapshot->array = NULL;
+  snapshot->length = 0;
+
+  if (__atomic_load_n(&l->retired, __ATOMIC_RELAXED) &&
+      pthread_rwlock_trywrlock(&l->lock) == 0) {
+    _reclaim(l);
+    _unlock(l);
+  }
+
+  return TSL_SUCCESS;
+}
+
+/* Sets value under the index.
+ * Index has to be smaller than list's length.
+ */
+tsl_error tsl_set(tsl_ptr l, size_t i, TSL_VALUE_TYPE value) {
+  return tsl_set_multi(l, i, 1, &value);
+}
+
+/* Sets `v_len` values, starting from the index.
+ * All indexes have to be smaller than list's length.
+ */
+tsl_error tsl_set_multi(tsl_ptr l, size_t i, size_t v_len,
+                        TSL_VALUE_TYPE values[]) {
+  tsl_error err = TSL_SUCCESS;
+
+  if (_is_overflow_size_t_add(i, v_len))
+    return TSL_ERROR_OVERFLOW;
+
+  _write_lock(l);
+
+  if (_is_i_too_big(l, i) || i + v_len > l->length) {
+    err = TSL_ERROR_INDEX_TOO_BIG;
+  } else {
+    _write_begin(l);
+    err = _prepare_write(l);
+    if (!err)
+      memcpy(l->array + i, values, v_len * TSL_VALUE_SIZE);
+    _write_end(l);
+  }
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Insert one element under the index.
+ * If index bigger than list's length, appends the value.
+ */
+tsl_error tsl_insert(tsl_ptr l, size_t i, TSL_VALUE_TYPE value) {
+  return tsl_insert_multi(l, i, 1, &value);
+}
+
+/* Appends one element to the list's end.
+ */
+tsl_error tsl_append(tsl_ptr l, TSL_VALUE_TYPE value) {
+  return tsl_insert_multi(l, TSL_SIZE_T_MAX, 1, &value);
+}
+
+/* Insert multiple elements under the index. Elements are moved once.
+ * If index bigger than list's length, appends the values.
+ */
+tsl_error tsl_insert_multi(tsl_ptr l, size_t i, size_t v_len,
+                           TSL_VALUE_TYPE values[]) {
+  tsl_error err;
+
+  _write_lock(l);
+
+  err = _insert_multi(l, i, v_len, values);
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Appends multiple elements to the list's end.
+ */
+tsl_error tsl_append_multi(tsl_ptr l, size_t v_len, TSL_VALUE_TYPE values[]) {
+  return tsl_insert_multi(l, TSL_SIZE_T_MAX, v_len, values);
+}
+
+/* Pops element from under the index. Sets value to the popped element's value.
+ * If list is empty, returns TSL_ERROR_POP_EMPTY_LIST.
+ * If i bigger than list's length, substitues it with maximum poppable i.
+ */
+tsl_error tsl_pop(tsl_ptr l, size_t i, TSL_VALUE_TYPE *value) {
+  tsl_error err;
+
+  _write_lock(l);
+
+  if (l->length == 0) {
+    err = TSL_ERROR_POP_EMPTY_LIST;
+  } else {
+    if (_is_i_too_big(l, i))
+      i = l->length - 1;
+
+    err = _pop_multi(l, i, 1, value);
+  }
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Pops `elements_amount` elements starting from the index into holder.
+ *  Unlike arl_pop_multi, count is exclusive (see tsl_list.h).
+ *  Holder's length has to be at least elements amount. Otherwise behaviour
+ *  is undefined. Elements are moved only once.
+ */
+tsl_error tsl_pop_multi(tsl_ptr l, size_t i, size_t elements_amount,
+                        TSL_VALUE_TYPE holder[]) {
+  tsl_error err;
+
+  if (_is_overflow_size_t_add(i, elements_amount))
+    return TSL_ERROR_OVERFLOW;
+
+  _write_lock(l);
+
+  if (_is_i_too_big(l, i))
+    err = TSL_ERROR_INDEX_TOO_BIG;
+  else if (i + elements_amount > l->length)
+    err = TSL_ERROR_INVALID_ARGS;
+  else
+    err = _pop_multi(l, i, elements_amount, holder);
+
+  _unlock(l);
+
+  return err;
+}
+
+/* Removes element from under the index.
+ * Executes callback function on removed element, only if callback is
+ *  not NULL. Callback is executed after the lock is released.
+ */
+tsl_error tsl_remove(tsl_ptr l, size_t i, void (*callback)(TSL_VALUE_TYPE)) {
+  TSL_VALUE_TYPE p;
+  tsl_error err;
+
+  err = tsl_pop(l, i, &p);
+  if (err)
+    return err;
+
+  if (callback)
+    callback(p);
+
+  return TSL_SUCCESS;
+}
+
+/* Removes all elements from the list.
+ * Executes callback function on each removed element, only if callback is
+ *  not NULL. Callback is executed with the lock held, so it cannot use
+ *  the list.
+ */
+tsl_error tsl_clear(tsl_ptr l, void (*callback)(TSL_VALUE_TYPE)) {
+  size_t i;
+
+  _write_lock(l);
+
+  if (callback) {
+    for (i = 0; i < l->length; i++) {
+      callback(l->array[i]);
+    }
+  }
+
+  _write_begin(l);
+  _set_length(l, 0);
+  _write_end(l);
+
+  _unlock(l);
+
+  return TSL_SUCCESS;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *tsl_strerror(tsl_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= TSL_ERROR_LEN) || (error >= TSL_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return TSL_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Checks if index is within list boundaries.
+ * Caller has to hold the lock.
+ */
+bool _is_i_too_big(tsl_ptr l, size_t i) { return i >= (l->length); }
+
+/* Seqlock's writer side. Caller has to hold the write lock.
+ */
+void _write_begin(tsl_ptr l) {
+  // Sequentially consistent, pairs with the store of `pinned` in
+  //  `tsl_snapshot_acquire`.
+  __atomic_store_n(&l->sequence, l->sequence + 1, __ATOMIC_SEQ_CST);
+  _sequence_fence(__ATOMIC_RELEASE);
+}
+
+void _write_end(tsl_ptr l) {
+  __atomic_store_n(&l->sequence, l->sequence + 1, __ATOMIC_RELEASE);
+}
+
+void _set_length(tsl_ptr l, size_t length) {
+  __atomic_store_n(&l->length, length, __ATOMIC_RELEASE);
+}
+
+/* Copies element for optimistic reader, see notes.
+ */
+TSL_NO_SANITIZE_THREAD void _copy_racy(TSL_VALUE_TYPE *dest,
+                                       TSL_VALUE_TYPE *array, size_t i) {
+  memcpy(dest, array + i, TSL_VALUE_SIZE);
+}
+
+/* Counts list's new capacity. The same formula as arl_list uses,
+ * but new capacity is at least `min_capacity`.
+ */
+static tsl_error _count_new_capacity(size_t current_length,
+                                     size_t current_capacity,
+                                     size_t min_capacity,
+                                     size_t *new_capacity) {
+  if (_is_overflow_size_t_multi(current_length, 3) ||
+      _is_overflow_size_t_add(current_capacity, 3 * current_length / 2)) {
+
+    return TSL_ERROR_OVERFLOW;
+  }
+
+  *new_capacity = 3 * current_length / 2 + current_capacity;
+
+  if (*new_capacity < min_capacity)
+    *new_capacity = min_capacity;
+
+  return TSL_SUCCESS;
+}
+
+/* Grows underlaying array, see notes.
+ * Caller has to hold the write lock and be inside of `_write_begin`.
+ */
+tsl_error _grow_array_capacity(tsl_ptr l, size_t min_capacity) {
+  size_t new_capacity;
+  tsl_error err;
+
+  err = _count_new_capacity(l->length, l->capacity, min_capacity,
+                            &new_capacity);
+  if (err)
+    return err;
+
+  return _replace_array(l, new_capacity);
+}
+
+/* Copies the array if snapshot uses it, so writer never modifies
+ *  snapshot's array. Caller has to be inside of `_write_begin`.
+ */
+tsl_error _prepare_write(tsl_ptr l) {
+  if (!__atomic_load_n(&l->pinned, __ATOMIC_SEQ_CST))
+    return TSL_SUCCESS;
+
+  return _replace_array(l, l->capacity);
+}
+
+/* Moves elements to new array and retires the old one, see notes.
+ * Caller has to hold the write lock and be inside of `_write_begin`.
+ */
+tsl_error _replace_array(tsl_ptr l, size_t new_capacity) {
+  struct tsl_retired *retired;
+  void *p;
+
+  if (_is_overflow_size_t_multi(new_capacity, TSL_VALUE_SIZE))
+    return TSL_ERROR_OVERFLOW;
+
+  retired = malloc(sizeof(struct tsl_retired));
+  if (!retired)
+    return TSL_ERROR_OUT_OF_MEMORY;
+
+  p = malloc(new_capacity * TSL_VALUE_SIZE);
+  if (!p) {
+    free(retired);
+    return TSL_ERROR_OUT_OF_MEMORY;
+  }
+
+  memcpy(p, l->array, l->length * TSL_VALUE_SIZE);
+
+  retired->array = l->array;
+  retired->epoch = l->epoch;
+  retired->next = l->retired;
+  __atomic_store_n(&l->retired, retired, __ATOMIC_RELAXED);
+
+  // Array is published before capacity, see `tsl_get_optimistic`.
+  __atomic_store_n(&l->array, p, __ATOMIC_RELEASE);
+  __atomic_store_n(&l->capacity, new_capacity, __ATOMIC_RELEASE);
+  // New array is not used by any snapshot.
+  __atomic_store_n(&l->pinned, 0, __ATOMIC_RELAXED);
+
+  // Readers entering from now on cannot see the retired array.
+  __atomic_store_n(&l->epoch, l->epoch + 1, __ATOMIC_SEQ_CST);
+
+  _reclaim(l);
+
+  return TSL_SUCCESS;
+}
+
+/* Inserts values, caller has to hold the write lock.
+ */
+tsl_error _insert_multi(tsl_ptr l, size_t i, size_t v_len,
+                        TSL_VALUE_TYPE values[]) {
+  size_t new_length;
+  tsl_error err = TSL_SUCCESS;
+
+  if (_is_i_too_big(l, i))
+    i = l->length;
+
+  if (_is_overflow_size_t_add(l->length, v_len))
+    return TSL_ERROR_OVERFLOW;
+
+  new_length = l->length + v_len;
+
+  _write_begin(l);
+
+  if (new_length > l->capacity)
+    err = _grow_array_capacity(l, new_length);
+  else
+    err = _prepare_write(l);
+
+  if (err)
+    goto OUT;
+
+  memmove(l->array + i + v_len, l->array + i,
+          (l->length - i) * TSL_VALUE_SIZE);
+  memcpy(l->array + i, values, v_len * TSL_VALUE_SIZE);
+
+  _set_length(l, new_length);
+
+OUT:
+  _write_end(l);
+
+  return err;
+}
+
+/* Pops values, caller has to hold the write lock and validate the range.
+ */
+tsl_error _pop_multi(tsl_ptr l, size_t i, size_t elements_amount,
+                     TSL_VALUE_TYPE holder[]) {
+  size_t end_i = i + elements_amount;
+  tsl_error err;
+
+  memcpy(holder, l->array + i, elements_amount * TSL_VALUE_SIZE);
+
+  _write_begin(l);
+
+  err = _prepare_write(l);
+  if (err)
+    goto OUT;
+
+  memmove(l->array + i, l->array + end_i, (l->length - end_i) * TSL_VALUE_SIZE);
+
+  _set_length(l, l->length - elements_amount);
+
+OUT:
+  _write_end(l);
+
+  return err;
+}
+
+/*******************************************************************************
+ *    EPOCH UTILS
+ ******************************************************************************/
+
+/* Thread remembers it's last slot, so readers in different threads do not
+ * compete for the same slots.
+ */
+#if defined(__GNUC__)
+static __thread size_t _slot_hint = 0;
+#else
+static size_t _slot_hint = 0;
+#endif
+
+/* Announces list's current epoch in a free reader's slot.
+ */
+tsl_error _epoch_enter(tsl_ptr l, size_t *slot) {
+  size_t epoch, expected, i, k;
+
+  epoch = __atomic_load_n(&l->epoch, __ATOMIC_SEQ_CST);
+
+  for (k = 0; k < TSL_READERS_MAX; k++) {
+    i = (_slot_hint + k) % TSL_READERS_MAX;
+    expected = 0;
+
+    if (__atomic_load_n(&l->readers[i].epoch, __ATOMIC_RELAXED) != 0)
+      continue;
+
+    if (__atomic_compare_exchange_n(&l->readers[i].epoch, &expected,
+                                    epoch + 1, false, __ATOMIC_SEQ_CST,
+                                    __ATOMIC_RELAXED)) {
+      _slot_hint = i;
+      *slot = i;
+      return TSL_SUCCESS;
+    }
+  }
+
+  return TSL_ERROR_SNAPSHOTS_EXHAUSTED;
+}
+
+void _epoch_exit(tsl_ptr l, size_t slot) {
+  __atomic_store_n(&l->readers[slot].epoch, 0, __ATOMIC_RELEASE);
+}
+
+/* Frees retired arrays which cannot be used by any reader.
+ * Caller has to hold the write lock.
+ */
+void _reclaim(tsl_ptr l) {
+  size_t oldest_epoch = TSL_SIZE_T_MAX, announced, i;
+  struct tsl_retired **node = &l->retired, *retired;
+
+  for (i = 0; i < TSL_READERS_MAX; i++) {
+    announced = __atomic_load_n(&l->readers[i].epoch, __ATOMIC_SEQ_CST);
+    if (announced && announced - 1 < oldest_epoch)
+      oldest_epoch = announced - 1;
+  }
+
+  while (*node) {
+    retired = *node;
+
+    if (retired->epoch < oldest_epoch) {
+      __atomic_store_n(node, retired->next, __ATOMIC_RELAXED);
+      free(retired->array);
+      free(retired);
+    } else {
+      node = &retired->next;
+    }
+  }
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+#define _is_overflow_add(a, b, max) (a > max - b)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, TSL_SIZE_T_MAX);
+}
+
+bool _is_overflow_size_t_add(size_t a, size_t b) {
+  return _is_overflow_add(a, b, TSL_SIZE_T_MAX);
+}
@@ -0,0 +1,840 @@
+/* Work stealing task scheduler. Each worker owns Chase-Lev deque, described */
+/*   here: https://www.dre.vanderbilt.edu/~schmidt/PDF/work-stealing-dequeue.pdf */
+
+/* Worker pushes and takes tasks at the bottom of it's own deque, without
+ * any synchronization in common case. Idle workers steal from the top of
+ * other workers' deques. So each worker processes it's own work depth first
+ * (good locality, bounded memory), while thieves take the oldest, usually the
+ * biggest, pieces of work.
+ * Tasks spawned from threads which are not scheduler's workers go to the
+ * shared injection queue, protected by a mutex.
+ * Waiting for a group does not block the thread, it executes other tasks
+ * until the group is done (help first). So fork/join recursion never
+ * needs more threads than workers. Threads which are not workers help
+ * while there is work to take, then sleep until a group is done.
+ */
+
+/* Notes:
+ * - Atomics are done by GCC's `__atomic` builtins, so the scheduler still
+ *     compiles as C99. Deque uses sequentially consistent operations instead
+ *     of fences (Lê et al. 2013 formulation), ThreadSanitizer understands
+ *     those.
+ * - Deque's array is never shrinked. When it grows, thieves may still read
+ *     the old one, so old arrays are kept until scheduler is destroyed. As
+ *     arrays grow geometrically, old ones take less memory than current one.
+ * - `wks_parallel_for` splits ranges lazily: thread processes `grain`
+ *     elements at a time and splits the rest in half only when it's own
+ *     deque (or injection queue, for threads which are not workers) is
+ *     empty, which means other workers took it's work and may be hungry.
+ *     Busy machine gets few big tasks, idle one gets many small.
+ * - Idle worker spins for a while and then sleeps on condition variable.
+ *     Spawning task bumps `work_epoch`, worker goes to sleep only if
+ *     the epoch did not change since it's last unsuccessful search.
+ */
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// App
+#include "wks_sched.h"
+#ifdef ENABLE_TESTS
+#include "cll_interfaces.h"
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DECLARATIONS
+ ******************************************************************************/
+#define WKS_CACHE_LINE_SIZE 64
+#define WKS_DEQUE_DEFAULT_CAPACITY 64
+/* Unsuccessful searches before worker goes to sleep. */
+#define WKS_IDLE_SPINS 64
+/* Default grain gives each worker this many pieces of a loop. */
+#define WKS_FOR_PIECES_PER_WORKER 8
+
+#ifndef WKS_WORKERS_MAX
+#define WKS_WORKERS_MAX 256
+#endif
+
+struct wks_task {
+  void (*function)(void *);
+  void *arg;
+  struct wks_group *group;
+  /* Next task in the injection queue. */
+  struct wks_task *next;
+};
+
+struct wks_array {
+  /* Power of two. */
+  size_t capacity;
+  /* Arrays replaced by growing, see notes. */
+  struct wks_array *retired;
+  struct wks_task *tasks[];
+};
+
+/* Top is written by thieves, bottom only by the owner. They live on separate
+ * cache lines, so owner's pushes do not invalidate thieves' line.
+ */
+struct wks_worker {
+  char _pad0[WKS_CACHE_LINE_SIZE];
+
+  ptrdiff_t top;
+  char _pad1[WKS_CACHE_LINE_SIZE - sizeof(ptrdiff_t)];
+
+  ptrdiff_t bottom;
+  struct wks_array *array;
+
+  wks_ptr scheduler;
+  pthread_t thread;
+  /* Victims are chosen randomly, xorshift state. */
+  size_t seed;
+  char _pad2[WKS_CACHE_LINE_SIZE];
+};
+
+struct wks_def {
+  struct wks_worker *workers;
+  size_t workers_amount;
+
+  /* Protects sleeping and injection queue. */
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  size_t sleepers;
+  /* Threads which are not workers, sleeping in `wks_wait`. */
+  pthread_cond_t group_done;
+  size_t waiters;
+  size_t work_epoch;
+  int shutdown;
+
+  /* Tasks spawned by threads which are not workers. */
+  struct wks_task *injected_head;
+  struct wks_task *injected_tail;
+  size_t injected_amount;
+};
+
+struct wks_for_context {
+  wks_ptr scheduler;
+  struct wks_group group;
+  size_t grain;
+  void (*body)(size_t start, size_t end, void *arg);
+  void *arg;
+};
+
+struct wks_for_range {
+  struct wks_for_context *context;
+  size_t start;
+  size_t end;
+};
+
+/* Worker executing current thread, NULL for other threads. */
+#if defined(__GNUC__)
+static __thread struct wks_worker *_current_worker = NULL;
+#else
+static struct wks_worker *_current_worker = NULL;
+#endif
+
+static struct wks_worker *_get_worker(wks_ptr s);
+static void *_worker_loop(void *arg);
+static struct wks_task *_find_task(wks_ptr s, struct wks_worker *w);
+static void _run_task(wks_ptr s, struct wks_task *task);
+static void _notify(wks_ptr s);
+static void _inject(wks_ptr s, struct wks_task *task);
+static struct wks_task *_pop_injected(wks_ptr s);
+static size_t _random_victim(struct wks_worker *w, size_t workers_amount);
+// Deque utils
+static wks_error _deque_init(struct wks_worker *w);
+static void _deque_destroy(struct wks_worker *w);
+static wks_error _deque_push(struct wks_worker *w, struct wks_task *task);
+static struct wks_task *_deque_take(struct wks_worker *w);
+static struct wks_task *_deque_steal(struct wks_worker *w, bool *aborted);
+static bool _deque_is_empty(struct wks_worker *w);
+static struct wks_array *_array_create(size_t capacity);
+// Loop utils
+static void _for_run(struct wks_for_context *context, size_t start,
+                     size_t end);
+static void _for_task(void *arg);
+static bool _is_hungry(wks_ptr s, struct wks_worker *w);
+// Pointers utils
+static bool _is_overflow_size_t_multi(size_t a, size_t b);
+
+// Error utils
+static const char *const WKS_ERROR_STRINGS[] = {
+    // 0
+    "Success",
+    // 1
+    "Invalid arguments",
+    // 2
+    "Overflow",
+    // 3
+    "Not enough memory",
+    // 4
+    "Unable to start worker thread",
+};
+
+static const size_t WKS_ERROR_STRINGS_LEN =
+    sizeof(WKS_ERROR_STRINGS) / sizeof(char *);
+
+/*******************************************************************************
+ *    PUBLIC API
+ ******************************************************************************/
+
+/* Creates scheduler's instance and starts it's workers.
+ * 0 workers stands for number of online processors.
+ */
+wks_error wks_create(wks_ptr *s, size_t workers_amount) {
+  wks_ptr s_local;
+  long processors;
+  wks_error err;
+  size_t i, k;
+
+  if (workers_amount > WKS_WORKERS_MAX)
+    return WKS_ERROR_INVALID_ARGS;
+
+  if (workers_amount == 0) {
+    processors = sysconf(_SC_NPROCESSORS_ONLN);
+    workers_amount = processors < 1 ? 1 : (size_t)processors;
+    if (workers_amount > WKS_WORKERS_MAX)
+      workers_amount = WKS_WORKERS_MAX;
+  }
+
+  s_local = malloc(sizeof(struct wks_def));
+  if (!s_local)
+    goto ERROR_OOM;
+
+  s_local->workers = malloc(workers_amount * sizeof(struct wks_worker));
+  if (!s_local->workers)
+    goto CLEANUP_S_LOCAL_OOM;
+
+  s_local->workers_amount = workers_amount;
+  s_local->sleepers = 0;
+  s_local->waiters = 0;
+  s_local->work_epoch = 0;
+  s_local->shutdown = 0;
+  s_local->injected_head = NULL;
+  s_local->injected_tail = NULL;
+  s_local->injected_amount = 0;
+
+  for (i = 0; i < workers_amount; i++) {
+    s_local->workers[i].scheduler = s_local;
+    s_local->workers[i].seed = i * 2654435761u + 1;
+
+    err = _deque_init(&s_local->workers[i]);
+    if (err)
+      goto CLEANUP_DEQUES;
+  }
+
+  if (pthread_mutex_init(&s_local->lock, NULL)) {
+    err = WKS_ERROR_THREAD;
+    goto CLEANUP_DEQUES;
+  }
+
+  if (pthread_cond_init(&s_local->wake, NULL)) {
+    err = WKS_ERROR_THREAD;
+    goto CLEANUP_LOCK;
+  }
+
+  if (pthread_cond_init(&s_local->group_done, NULL)) {
+    err = WKS_ERROR_THREAD;
+    goto CLEANUP_WAKE;
+  }
+
+  for (k = 0; k < workers_amount; k++) {
+    if (pthread_create(&s_local->workers[k].thread, NULL, _worker_loop,
+                       &s_local->workers[k])) {
+      err = WKS_ERROR_THREAD;
+      goto CLEANUP_THREADS;
+    }
+  }
+
+  *s = s_local;
+
+  return WKS_SUCCESS;
+
+CLEANUP_THREADS:
+  pthread_mutex_lock(&s_local->lock);
+  s_local->shutdown = 1;
+  pthread_cond_broadcast(&s_local->wake);
+  pthread_mutex_unlock(&s_local->lock);
+  while (k-- > 0) {
+    pthread_join(s_local->workers[k].thread, NULL);
+  }
+  pthread_cond_destroy(&s_local->group_done);
+CLEANUP_WAKE:
+  pthread_cond_destroy(&s_local->wake);
+CLEANUP_LOCK:
+  pthread_mutex_destroy(&s_local->lock);
+CLEANUP_DEQUES:
+  while (i-- > 0) {
+    _deque_destroy(&s_local->workers[i]);
+  }
+  free(s_local->workers);
+  free(s_local);
+  return err;
+
+CLEANUP_S_LOCAL_OOM:
+  free(s_local);
+ERROR_OOM:
+  return WKS_ERROR_OUT_OF_MEMORY;
+}
+
+/* Stops workers and frees resources allocated for scheduler's instance.
+ * All groups have to be waited for before, no thread can use the scheduler
+ *  while it's destroyed.
+ */
+wks_error wks_destroy(wks_ptr s) {
+  size_t i;
+
+  pthread_mutex_lock(&s->lock);
+  __atomic_store_n(&s->shutdown, 1, __ATOMIC_RELAXED);
+  pthread_cond_broadcast(&s->wake);
+  pthread_mutex_unlock(&s->lock);
+
+  for (i = 0; i < s->workers_amount; i++) {
+    pthread_join(s->workers[i].thread, NULL);
+  }
+
+  for (i = 0; i < s->workers_amount; i++) {
+    _deque_destroy(&s->workers[i]);
+  }
+
+  pthread_cond_destroy(&s->group_done);
+  pthread_cond_destroy(&s->wake);
+  pthread_mutex_destroy(&s->lock);
+  free(s->workers);
+  free(s);
+
+  return WKS_SUCCESS;
+}
+
+/* Returns number of scheduler's workers. */
+size_t wks_workers_amount(wks_ptr s) { return s->workers_amount; }
+
+void wks_group_init(struct wks_group *group) { group->pending = 0; }
+
+/* Spawns task executing `function(arg)` as part of the group.
+ * Task may be executed by any worker, or by a thread waiting for a group.
+ */
+wks_error wks_spawn(wks_ptr s, struct wks_group *group,
+                    void (*function)(void *), void *arg) {
+  struct wks_worker *w = _get_worker(s);
+  struct wks_task *task;
+
+  task = malloc(sizeof(struct wks_task));
+  if (!task)
+    return WKS_ERROR_OUT_OF_MEMORY;
+
+  task->function = function;
+  task->arg = arg;
+  task->group = group;
+  task->next = NULL;
+
+  __atomic_add_fetch(&group->pending, 1, __ATOMIC_RELAXED);
+
+  if (w) {
+    if (_deque_push(w, task))
+      goto CLEANUP_TASK_OOM;
+  } else {
+    _inject(s, task);
+  }
+
+  _notify(s);
+
+  return WKS_SUCCESS;
+
+CLEANUP_TASK_OOM:
+  __atomic_sub_fetch(&group->pending, 1, __ATOMIC_RELAXED);
+  free(task);
+  return WKS_ERROR_OUT_OF_MEMORY;
+}
+
+/* Waits until all tasks of the group are done. Meanwhile executes other
+ *  tasks, so waiting inside of a task does not block the worker. Thread
+ *  which is not a worker sleeps, once there is nothing to take.
+ */
+wks_error wks_wait(wks_ptr s, struct wks_group *group) {
+  struct wks_worker *w = _get_worker(s);
+  struct wks_task *task;
+
+  while (__atomic_load_n(&group->pending, __ATOMIC_SEQ_CST)) {
+    task = _find_task(s, w);
+    if (task) {
+      _run_task(s, task);
+      continue;
+    }
+
+    // Worker keeps looking, it's group's tasks may spawn new ones.
+    if (w) {
+      sched_yield();
+      continue;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    __atomic_add_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    // Pairs with `_run_task`, either finishing task sees the waiter or
+    //  waiter sees the group done.
+    while (__atomic_load_n(&group->pending, __ATOMIC_SEQ_CST))
+      pthread_cond_wait(&s->group_done, &s->lock);
+    __atomic_sub_fetch(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&s->lock);
+  }
+
+  return WKS_SUCCESS;
+}
+
+/* Executes body over [start, end) in parallel. Body gets subranges of at
+ *  least `grain` elements (except the last one). 0 grain stands for
+ *  automatic grain. Returns once whole range is done.
+ */
+wks_error wks_parallel_for(wks_ptr s, size_t start, size_t end, size_t grain,
+                           void (*body)(size_t start, size_t end, void *arg),
+                           void *arg) {
+  struct wks_for_context context;
+  struct wks_for_range *range;
+  wks_error err;
+
+  if (start > end)
+    return WKS_ERROR_INVALID_ARGS;
+
+  if (start == end)
+    return WKS_SUCCESS;
+
+  if (grain == 0) {
+    if (_is_overflow_size_t_multi(s->workers_amount,
+                                  WKS_FOR_PIECES_PER_WORKER))
+      return WKS_ERROR_OVERFLOW;
+
+    grain = (end - start) / (s->workers_amount * WKS_FOR_PIECES_PER_WORKER);
+    if (grain == 0)
+      grain = 1;
+  }
+
+  context.scheduler = s;
+  context.grain = grain;
+  context.body = body;
+  context.arg = arg;
+  wks_group_init(&context.group);
+
+  if (_get_worker(s)) {
+    // Worker splits the range itself.
+    _for_run(&context, start, end);
+  } else {
+    // Other threads hand the range over to workers.
+    range = malloc(sizeof(struct wks_for_range));
+    if (!range)
+      return WKS_ERROR_OUT_OF_MEMORY;
+
+    range->context = &context;
+    range->start = start;
+    range->end = end;
+
+    err = wks_spawn(s, &context.group, _for_task, range);
+    if (err) {
+      free(range);
+      return err;
+    }
+  }
+
+  return wks_wait(s, &context.group);
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS
+ ******************************************************************************/
+
+const char *wks_strerror(wks_error error) {
+  // Return string on success, NULL on failure.
+  // Mimics arl_strerror.
+
+  if ( // Upper bound
+      (error >= WKS_ERROR_LEN) || (error >= WKS_ERROR_STRINGS_LEN) ||
+      // Lower bound
+      (error < 0))
+    return NULL;
+
+  return WKS_ERROR_STRINGS[error];
+}
+
+/*******************************************************************************
+ *    PRIVATE API
+ ******************************************************************************/
+
+/* Returns current thread's worker, if it belongs to the scheduler.
+ */
+struct wks_worker *_get_worker(wks_ptr s) {
+  if (_current_worker && _current_worker->scheduler == s)
+    return _current_worker;
+
+  return NULL;
+}
+
+void *_worker_loop(void *arg) {
+  struct wks_worker *w = arg;
+  wks_ptr s = w->scheduler;
+  struct wks_task *task;
+  size_t epoch, idle = 0;
+
+  _current_worker = w;
+
+  while (!__atomic_load_n(&s->shutdown, __ATOMIC_RELAXED)) {
+    epoch = __atomic_load_n(&s->work_epoch, __ATOMIC_SEQ_CST);
+
+    task = _find_task(s, w);
+    if (task) {
+      _run_task(s, task);
+      idle = 0;
+      continue;
+    }
+
+    if (++idle < WKS_IDLE_SPINS) {
+      sched_yield();
+      continue;
+    }
+
+    idle = 0;
+
+    pthread_mutex_lock(&s->lock);
+    __atomic_add_fetch(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+    // Pairs with `_notify`, either spawner sees the sleeper or worker sees
+    //  changed epoch.
+    if (__atomic_load_n(&s->work_epoch, __ATOMIC_SEQ_CST) == epoch &&
+        !s->shutdown)
+      pthread_cond_wait(&s->wake, &s->lock);
+    __atomic_sub_fetch(&s->sleepers, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&s->lock);
+  }
+
+  return NULL;
+}
+
+/* Looks for a task: in own deque, in injection queue and finally in other
+ *  workers' deques. `w` is NULL for threads which are not workers.
+ */
+struct wks_task *_find_task(wks_ptr s, struct wks_worker *w) {
+  struct wks_task *task;
+  size_t first, i;
+  bool aborted;
+
+  if (w) {
+    task = _deque_take(w);
+    if (task)
+      return task;
+  }
+
+  task = _pop_injected(s);
+  if (task)
+    return task;
+
+  do {
+    aborted = false;
+    first = w ? _random_victim(w, s->workers_amount) : 0;
+
+    for (i = 0; i < s->workers_amount; i++) {
+      struct wks_worker *victim = &s->workers[(first + i) % s->workers_amount];
+
+      if (victim == w)
+        continue;
+
+      task = _deque_steal(victim, &aborted);
+      if (task)
+        return task;
+    }
+    // Lost race with other thief, victim may still have work.
+  } while (aborted);
+
+  return NULL;
+}
+
+/* Runs the task. Last task of a group wakes up threads sleeping in
+ *  `wks_wait`, group itself may be gone once pending drops to 0.
+ */
+void _run_task(wks_ptr s, struct wks_task *task) {
+  struct wks_group *group = task->group;
+
+  task->function(task->arg);
+  free(task);
+
+  if (__atomic_sub_fetch(&group->pending, 1, __ATOMIC_SEQ_CST) == 0 &&
+      __atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST)) {
+    pthread_mutex_lock(&s->lock);
+    pthread_cond_broadcast(&s->group_done);
+    pthread_mutex_unlock(&s->lock);
+  }
+}
+
+/* Wakes up sleeping worker, if there is any.
+ */
+void _notify(wks_ptr s) {
+  __atomic_add_fetch(&s->work_epoch, 1, __ATOMIC_SEQ_CST);
+
+  if (__atomic_load_n(&s->sleepers, __ATOMIC_SEQ_CST)) {
+    pthread_mutex_lock(&s->lock);
+    pthread_cond_signal(&s->wake);
+    pthread_mutex_unlock(&s->lock);
+  }
+}
+
+void _inject(wks_ptr s, struct wks_task *task) {
+  pthread_mutex_lock(&s->lock);
+
+  if (s->injected_tail)
+    s->injected_tail->next = task;
+  else
+    s->injected_head = task;
+  s->injected_tail = task;
+
+  __atomic_add_fetch(&s->injected_amount, 1, __ATOMIC_RELAXED);
+
+  pthread_mutex_unlock(&s->lock);
+}
+
+struct wks_task *_pop_injected(wks_ptr s) {
+  struct wks_task *task;
+
+  // Common case, do not touch the lock.
+  if (!__atomic_load_n(&s->injected_amount, __ATOMIC_RELAXED))
+    return NULL;
+
+  pthread_mutex_lock(&s->lock);
+
+  task = s->injected_head;
+  if (task) {
+    s->injected_head = task->next;
+    if (!s->injected_head)
+      s->injected_tail = NULL;
+
+    __atomic_sub_fetch(&s->injected_amount, 1, __ATOMIC_RELAXED);
+  }
+
+  pthread_mutex_unlock(&s->lock);
+
+  return task;
+}
+
+size_t _random_victim(struct wks_worker *w, size_t workers_amount) {
+  w->seed ^= w->seed << 13;
+  w->seed ^= w->seed >> 7;
+  w->seed ^= w->seed << 17;
+
+  return w->seed % workers_amount;
+}
+
+/*******************************************************************************
+ *    DEQUE UTILS
+ ******************************************************************************/
+
+wks_error _deque_init(struct wks_worker *w) {
+  w->array = _array_create(WKS_DEQUE_DEFAULT_CAPACITY);
+  if (!w->array)
+    return WKS_ERROR_OUT_OF_MEMORY;
+
+  w->top = 0;
+  w->bottom = 0;
+
+  return WKS_SUCCESS;
+}
+
+void _deque_destroy(struct wks_worker *w) {
+  struct wks_array *array = w->array, *retired;
+
+  while (array) {
+    retired = array->retired;
+    free(array);
+    array = retired;
+  }
+}
+
+struct wks_array *_array_create(size_t capacity) {
+  struct wks_array *array;
+
+  if (_is_overflow_size_t_multi(capacity, sizeof(struct wks_task *)))
+    return NULL;
+
+  array = malloc(sizeof(struct wks_array) +
+                 capacity * sizeof(struct wks_task *));
+  if (!array)
+    return NULL;
+
+  array->capacity = capacity;
+  array->retired = NULL;
+
+  return array;
+}
+
+/* Pushes task at the bottom. Called only by the owner.
+ */
+wks_error _deque_push(struct wks_worker *w, struct wks_task *task) {
+  struct wks_array *array, *new_array;
+  ptrdiff_t bottom, top, i;
+
+  bottom = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED);
+  top = __atomic_load_n(&w->top, __ATOMIC_ACQUIRE);
+  array = __atomic_load_n(&w->array, __ATOMIC_RELAXED);
+
+  if ((size_t)(bottom - top) >= array->capacity) {
+    new_array = _array_create(array->capacity * 2);
+    if (!new_array)
+      return WKS_ERROR_OUT_OF_MEMORY;
+
+    for (i = top; i < bottom; i++) {
+      new_array->tasks[i & (new_array->capacity - 1)] = __atomic_load_n(
+          &array->tasks[i & (array->capacity - 1)], __ATOMIC_RELAXED);
+    }
+
+    new_array->retired = array;
+    __atomic_store_n(&w->array, new_array, __ATOMIC_RELEASE);
+    array = new_array;
+  }
+
+  __atomic_store_n(&array->tasks[bottom & (array->capacity - 1)], task,
+                   __ATOMIC_RELAXED);
+  __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+  return WKS_SUCCESS;
+}
+
+/* Takes task from the bottom. Called only by the owner.
+ */
+struct wks_task *_deque_take(struct wks_worker *w) {
+  struct wks_array *array;
+  struct wks_task *task;
+  ptrdiff_t bottom, top;
+
+  bottom = __atomic_load_n(&w->bottom, __ATOMIC_RELAXED) - 1;
+  array = __atomic_load_n(&w->array, __ATOMIC_RELAXED);
+  // Sequentially consistent store and load, thieves have to see the
+  //  reservation before owner reads top.
+  __atomic_store_n(&w->bottom, bottom, __ATOMIC_SEQ_CST);
+  top = __atomic_load_n(&w->top, __ATOMIC_SEQ_CST);
+
+  if (top > bottom) {
+    // Deque was empty.
+    __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELAXED);
+    return NULL;
+  }
+
+  task = __atomic_load_n(&array->tasks[bottom & (array->capacity - 1)],
+                         __ATOMIC_RELAXED);
+
+  if (top == bottom) {
+    // Last task, race with thieves.
+    if (!__atomic_compare_exchange_n(&w->top, &top, top + 1, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+      task = NULL;
+
+    __atomic_store_n(&w->bottom, bottom + 1, __ATOMIC_RELAXED);
+  }
+
+  return task;
+}
+
+/* Steals task from the top. Called by any thread. `aborted` is set if
+ *  other thread won the race for the task.
+ */
+struct wks_task *_deque_steal(struct wks_worker *w, bool *aborted) {
+  struct wks_array *array;
+  struct wks_task *task;
+  ptrdiff_t bottom, top;
+
+  top = __atomic_load_n(&w->top, __ATOMIC_SEQ_CST);
+  bottom = __atomic_load_n(&w->bottom, __ATOMIC_SEQ_CST);
+
+  if (top >= bottom)
+    return NULL;
+
+  array = __atomic_load_n(&w->array, __ATOMIC_ACQUIRE);
+  task = __atomic_load_n(&array->tasks[top & (array->capacity - 1)],
+                         __ATOMIC_RELAXED);
+
+  if (!__atomic_compare_exchange_n(&w->top, &top, top + 1, false,
+                                   __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+    *aborted = true;
+    return NULL;
+  }
+
+  return task;
+}
+
+/* Owner's hint, thieves may change it meanwhile. */
+bool _deque_is_empty(struct wks_worker *w) {
+  return __atomic_load_n(&w->bottom, __ATOMIC_RELAXED) <=
+         __atomic_load_n(&w->top, __ATOMIC_RELAXED);
+}
+
+/*******************************************************************************
+ *    LOOP UTILS
+ ******************************************************************************/
+
+/* Processes the range grain by grain, splitting off the upper half whenever
+ *  own deque is empty, see notes.
+ */
+void _for_run(struct wks_for_context *context, size_t start, size_t end) {
+  struct wks_worker *w = _get_worker(context->scheduler);
+  struct wks_for_range *range;
+  size_t middle, chunk_end;
+
+  while (start < end) {
+    if (end - start > context->grain && _is_hungry(context->scheduler, w)) {
+      middle = start + (end - start) / 2;
+
+      range = malloc(sizeof(struct wks_for_range));
+      if (range) {
+        range->context = context;
+        range->start = middle;
+        range->end = end;
+
+        if (wks_spawn(context->scheduler, &context->group, _for_task,
+                      range) == WKS_SUCCESS) {
+          end = middle;
+          continue;
+        }
+
+        free(range);
+      }
+      // Not enough memory to split, process the range sequentially.
+    }
+
+    chunk_end = end - start > context->grain ? start + context->grain : end;
+    context->body(start, chunk_end, context->arg);
+    start = chunk_end;
+  }
+}
+
+/* Tells whether spawned work would be taken soon. Worker's deque is empty
+ *  after it's tasks were stolen, injection queue is empty after workers
+ *  took injected tasks.
+ */
+bool _is_hungry(wks_ptr s, struct wks_worker *w) {
+  if (w)
+    return _deque_is_empty(w);
+
+  return !__atomic_load_n(&s->injected_amount, __ATOMIC_RELAXED);
+}
+
+void _for_task(void *arg) {
+  struct wks_for_range *range = arg;
+  struct wks_for_context *context = range->context;
+  size_t start = range->start, end = range->end;
+
+  free(range);
+
+  _for_run(context, start, end);
+}
+
+/*******************************************************************************
+ *    OVERFLOW UTILS
+ ******************************************************************************/
+#define _is_overflow_multi(a, b, max) (a != 0) && (b > max / a)
+
+bool _is_overflow_size_t_multi(size_t a, size_t b) {
+  return _is_overflow_multi(a, b, WKS_SIZE_T_MAX);
+}
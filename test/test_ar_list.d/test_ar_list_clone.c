@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+int arl_small_values[] = {0, 1, 2, 3, 4, 5};
+size_t arl_small_length = sizeof(arl_small_values) / sizeof(int);
+const size_t default_capacity = 6;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (arl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  if (arl_insert_multi(l, 0, arl_small_length, arl_small_values))
+    TEST_FAIL_MESSAGE("Unable to fill list!");
+}
+
+void tearDown(void) {
+  arl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_clone_shares_array(void) {
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+
+  TEST_ASSERT_EQUAL_PTR(l->array, clone->array);
+  TEST_ASSERT_EQUAL(arl_small_length, arl_length(clone));
+  TEST_ASSERT_EQUAL(2, *l->refs);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(clone));
+  TEST_ASSERT_EQUAL(1, *l->refs);
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, l->array, arl_small_length);
+}
+
+void test_arl_clone_copy_on_set(void) {
+  arl_ptr clone;
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(clone, 0, 100));
+
+  TEST_ASSERT_TRUE(l->array != clone->array);
+  TEST_ASSERT_NULL(clone->refs);
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, l->array, arl_small_length);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(clone, 0, &value));
+  TEST_ASSERT_EQUAL(100, value);
+
+  // Original is the only user now, writing does not copy.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(l, 1, 101));
+  TEST_ASSERT_NULL(l->refs);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(clone));
+}
+
+void test_arl_clone_copy_on_insert_and_pop(void) {
+  arl_ptr first_clone, second_clone;
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &first_clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(first_clone, &second_clone));
+  TEST_ASSERT_EQUAL(3, *l->refs);
+
+  // Growing shared array has to copy it too.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(first_clone, 6));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(second_clone, 0, &value));
+  TEST_ASSERT_EQUAL(0, value);
+  TEST_ASSERT_EQUAL(1, *l->refs);
+
+  TEST_ASSERT_EQUAL(arl_small_length, arl_length(l));
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, l->array, arl_small_length);
+  TEST_ASSERT_EQUAL(arl_small_length + 1, arl_length(first_clone));
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, first_clone->array,
+                              arl_small_length);
+  TEST_ASSERT_EQUAL(arl_small_length - 1, arl_length(second_clone));
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values + 1, second_clone->array,
+                              arl_small_length - 1);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(first_clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(second_clone));
+}
+
+void test_arl_clone_outlives_original(void) {
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(l));
+  l = clone;
+
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, l->array, arl_small_length);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear(l, NULL));
+  TEST_ASSERT_NULL(l->refs);
+  TEST_ASSERT_EQUAL(0, arl_length(l));
+}
+
+int cleared_sum = 0;
+
+void sum_cleared(int value) { cleared_sum += value; }
+
+void test_arl_clear_shared_does_not_copy(void) {
+  ARL_VALUE_TYPE *shared;
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+  shared = l->array;
+
+  cleared_sum = 0;
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear(clone, sum_cleared));
+  TEST_ASSERT_EQUAL(15, cleared_sum);
+
+  // Clone got new array of the same capacity, original keeps the old one.
+  TEST_ASSERT_NULL(clone->refs);
+  TEST_ASSERT_TRUE(clone->array != shared);
+  TEST_ASSERT_EQUAL(default_capacity, clone->capacity);
+  TEST_ASSERT_EQUAL(0, arl_length(clone));
+  TEST_ASSERT_EQUAL(1, *l->refs);
+  TEST_ASSERT_EQUAL_PTR(shared, l->array);
+  TEST_ASSERT_EQUAL_INT_ARRAY(arl_small_values, l->array, arl_small_length);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(clone, 7));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(clone));
+}
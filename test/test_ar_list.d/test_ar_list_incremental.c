@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+const size_t default_capacity = 64;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  size_t i;
+
+  if (arl_create_incremental(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  for (i = 0; i < default_capacity; i++) {
+    if (arl_append(l, (int)i))
+      TEST_FAIL_MESSAGE("Unable to fill list!");
+  }
+}
+
+void tearDown(void) {
+  arl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+/* Checks that element under index i holds i, for whole list. */
+void TEST_ASSERT_LIST_INDEXES(arl_ptr l) {
+  size_t i;
+  int value;
+
+  for (i = 0; i < arl_length(l); i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, i, &value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_incremental_growth_does_not_copy(void) {
+  TEST_ASSERT_NULL(l->old_array);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 64));
+
+  // Old array holds all elements, but the one appended.
+  TEST_ASSERT_NOT_NULL(l->old_array);
+  TEST_ASSERT_EQUAL(0, l->migrated);
+  TEST_ASSERT_EQUAL(default_capacity, l->migration_end);
+  TEST_ASSERT_EQUAL(65, arl_length(l));
+  TEST_ASSERT_LIST_INDEXES(l);
+}
+
+void test_arl_incremental_migrates_by_steps(void) {
+  size_t i = default_capacity;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, (int)i++));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, (int)i++));
+  TEST_ASSERT_EQUAL(ARL_INCREMENTAL_STEP, l->migrated);
+
+  while (l->old_array) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, (int)i++));
+    TEST_ASSERT_LIST_INDEXES(l);
+  }
+
+  // Migration ends before list fills the new array.
+  TEST_ASSERT_TRUE(arl_length(l) < l->capacity);
+  TEST_ASSERT_EQUAL(1 + default_capacity / ARL_INCREMENTAL_STEP,
+                    arl_length(l) - default_capacity);
+}
+
+void test_arl_incremental_set_while_migrating(void) {
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 64));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(l, 10, 100));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(l, 64, 101));
+
+  while (l->old_array)
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 0));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 10, &value));
+  TEST_ASSERT_EQUAL(100, value);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 64, &value));
+  TEST_ASSERT_EQUAL(101, value);
+}
+
+void test_arl_incremental_insert_finishes_migration(void) {
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 65));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_insert(l, 0, -1));
+
+  TEST_ASSERT_NULL(l->old_array);
+  TEST_ASSERT_EQUAL(66, arl_length(l));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 0, &value));
+  TEST_ASSERT_EQUAL(-1, value);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 64, &value));
+  TEST_ASSERT_EQUAL(63, value);
+}
+
+void test_arl_incremental_pop_from_end_while_migrating(void) {
+  size_t length;
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 64));
+
+  // Pops elements both from the new and the old array.
+  for (length = arl_length(l); length > 1; length--) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, length - 1, &value));
+    TEST_ASSERT_EQUAL(length - 1, value);
+  }
+
+  TEST_ASSERT_EQUAL(1, l->migration_end);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 0, &value));
+  TEST_ASSERT_EQUAL(0, value);
+
+  // Nothing left to migrate.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, 0, &value));
+  TEST_ASSERT_NULL(l->old_array);
+}
+
+void test_arl_incremental_slice_and_clear_while_migrating(void) {
+  int slice[65];
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 64));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 65));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_slice(l, 1, 64, slice));
+  for (i = 0; i < 65; i++)
+    TEST_ASSERT_EQUAL(i + 1, slice[i]);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear(l, NULL));
+  TEST_ASSERT_NULL(l->old_array);
+  TEST_ASSERT_EQUAL(0, arl_length(l));
+}
+
+void test_arl_incremental_clone_finishes_migration(void) {
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 64));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+
+  TEST_ASSERT_NULL(l->old_array);
+  TEST_ASSERT_EQUAL_PTR(l->array, clone->array);
+  TEST_ASSERT_LIST_INDEXES(clone);
+
+  // Clone grows incrementally too, after copying the shared array.
+  while (arl_length(clone) < clone->capacity)
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                            arl_append(clone, (int)arl_length(clone)));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_append(clone, (int)arl_length(clone)));
+  TEST_ASSERT_NOT_NULL(clone->old_array);
+  TEST_ASSERT_LIST_INDEXES(clone);
+  TEST_ASSERT_LIST_INDEXES(l);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(clone));
+}
+
+void test_arl_incremental_many_growths(void) {
+  size_t i;
+
+  for (i = arl_length(l); i < 100000; i++)
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, (int)i));
+
+  TEST_ASSERT_LIST_INDEXES(l);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_shrink(l));
+  TEST_ASSERT_NULL(l->old_array);
+  TEST_ASSERT_EQUAL(100000, l->capacity);
+  TEST_ASSERT_LIST_INDEXES(l);
+}
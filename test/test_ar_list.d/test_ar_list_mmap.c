@@ -0,0 +1,465 @@
+// Same feature macros as arl_list.c, it is included after system headers.
+#define _GNU_SOURCE
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH 10000
+
+const char *file_path = "test_ar_list_mmap.bin";
+const size_t default_capacity = 4;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  remove(file_path);
+
+  if (arl_create_mmap(&l, file_path, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  if (l)
+    arl_destroy(l);
+
+  remove(file_path);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+void fill_list(size_t length) {
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, (int)i * 3));
+  }
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_create_mmap_grows_file(void) {
+  fill_list(VALUES_LENGTH);
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arl_length(l));
+  TEST_ASSERT_TRUE(l->capacity >= VALUES_LENGTH);
+  TEST_ASSERT_EQUAL(_file_size(l->capacity), l->mapping.size);
+  TEST_ASSERT_EQUAL_PTR((char *)l->mapping.address +
+                            sizeof(struct arl_file_header),
+                        l->array);
+}
+
+void test_arl_create_mmap_reopen_restores_list(void) {
+  int value;
+  size_t i;
+
+  fill_list(VALUES_LENGTH);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, 0, &value));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(l));
+
+  // Default capacity is ignored for existing file.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create_mmap(&l, file_path, 1));
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH - 1, arl_length(l));
+  for (i = 0; i < VALUES_LENGTH - 1; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, i, &value));
+    TEST_ASSERT_EQUAL((int)(i + 1) * 3, value);
+  }
+
+  // Reopened list keeps growing.
+  fill_list(VALUES_LENGTH);
+  TEST_ASSERT_EQUAL(2 * VALUES_LENGTH - 1, arl_length(l));
+}
+
+void test_arl_create_mmap_serialized_empty_list_grows(void) {
+  arl_ptr empty;
+  int value, fd;
+
+  arl_destroy(l);
+  l = NULL;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create(&empty, 1));
+  fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize_fd(empty, fd));
+  close(fd);
+  arl_destroy(empty);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_create_mmap(&l, file_path, default_capacity));
+  TEST_ASSERT_EQUAL(0, arl_length(l));
+  TEST_ASSERT_EQUAL(default_capacity, l->capacity);
+
+  fill_list(VALUES_LENGTH);
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arl_length(l));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, 7, &value));
+  TEST_ASSERT_EQUAL(21, value);
+}
+
+void test_arl_sync_persists_length(void) {
+  struct arl_file_header header;
+  FILE *file;
+
+  fill_list(10);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_sync(l));
+
+  file = fopen(file_path, "rb");
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_EQUAL(1, fread(&header, sizeof(header), 1, file));
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, _file_header_validate(&header));
+  TEST_ASSERT_EQUAL(10, header.length);
+}
+
+void test_arl_create_mmap_invalid_format_failure(void) {
+  FILE *file;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(l));
+  l = NULL;
+
+  // Corrupt the magic.
+  file = fopen(file_path, "r+b");
+  TEST_ASSERT_NOT_NULL(file);
+  fputc('X', file);
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_FORMAT,
+                          arl_create_mmap(&l, file_path, default_capacity));
+  l = NULL;
+}
+
+void test_arl_create_mmap_io_failure(void) {
+  arl_ptr other;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_ERROR_IO,
+      arl_create_mmap(&other, "not/existing/dir/list.bin", default_capacity));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS,
+                          arl_create_mmap(&other, file_path, 0));
+}
+
+void test_arl_clone_mmap_failure(void) {
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS, arl_clone(l, &clone));
+}
+
+void test_arl_create_reserved_grows_in_place(void) {
+  arl_ptr reserved;
+  int *array, value;
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS,
+      arl_create_reserved(&reserved, default_capacity, VALUES_LENGTH));
+  array = reserved->array;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(reserved, (int)i));
+  }
+
+  TEST_ASSERT_EQUAL_PTR(array, reserved->array);
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(reserved, i, &value));
+    TEST_ASSERT_EQUAL((int)i, value);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(reserved));
+}
+
+void test_arl_create_reserved_full_failure(void) {
+  arl_ptr reserved;
+  size_t i, max_capacity;
+
+  // Reservation is rounded up to whole pages, list stops at max capacity
+  // anyway.
+  max_capacity = VALUES_LENGTH + 1;
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS,
+      arl_create_reserved(&reserved, default_capacity, max_capacity));
+  TEST_ASSERT_TRUE(reserved->mapping.size / sizeof(int) > max_capacity);
+
+  for (i = 0; i < max_capacity; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(reserved, (int)i));
+  }
+
+  TEST_ASSERT_EQUAL(max_capacity, reserved->capacity);
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_OVERFLOW, arl_append(reserved, 0));
+  TEST_ASSERT_EQUAL(max_capacity, arl_length(reserved));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(reserved));
+}
+
+void test_arl_create_reserved_invalid_args_failure(void) {
+  arl_ptr reserved;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS,
+                          arl_create_reserved(&reserved, 0, VALUES_LENGTH));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS,
+                          arl_create_reserved(&reserved, 10, 9));
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_ERROR_OVERFLOW,
+      arl_create_reserved(&reserved, 1, ARL_SIZE_T_MAX / sizeof(int) + 1));
+}
+
+void test_arl_clone_reserved_failure(void) {
+  arl_ptr reserved, clone;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS,
+      arl_create_reserved(&reserved, default_capacity, VALUES_LENGTH));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS, arl_clone(reserved, &clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(reserved));
+}
+
+/* Counts resident pages of the list's array between elements `start` and
+ *  `end`.
+ */
+size_t resident_pages(arl_ptr list, size_t start, size_t end) {
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE), pages, i, resident = 0;
+  uintptr_t from, till;
+  unsigned char *vector;
+
+  from = ((uintptr_t)(list->array + start) + page_size - 1) / page_size *
+         page_size;
+  till = (uintptr_t)(list->array + end) / page_size * page_size;
+  if (from >= till)
+    return 0;
+
+  pages = (till - from) / page_size;
+  vector = malloc(pages);
+  TEST_ASSERT_NOT_NULL(vector);
+  TEST_ASSERT_EQUAL(0, mincore((void *)from, till - from, vector));
+
+  for (i = 0; i < pages; i++) {
+    resident += vector[i] & 1;
+  }
+
+  free(vector);
+
+  return resident;
+}
+
+void test_arl_create_large_aligned(void) {
+  arl_ptr large;
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS, arl_create_large(&large, default_capacity, VALUES_LENGTH));
+
+  TEST_ASSERT_EQUAL(0, (uintptr_t)large->array % ARL_LARGE_PAGE_SIZE);
+  TEST_ASSERT_EQUAL(0, large->mapping.size % ARL_LARGE_PAGE_SIZE);
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(large, (int)i));
+  }
+  TEST_ASSERT_EQUAL_PTR(large->mapping.address, large->array);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(large));
+}
+
+void test_arl_clear_reserved_releases_pages(void) {
+  arl_ptr reserved;
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS,
+      arl_create_reserved(&reserved, default_capacity, VALUES_LENGTH));
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(reserved, (int)i));
+  }
+  TEST_ASSERT_TRUE(resident_pages(reserved, 0, VALUES_LENGTH) > 0);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear(reserved, NULL));
+
+  TEST_ASSERT_EQUAL(0, resident_pages(reserved, 0, VALUES_LENGTH));
+  // Address range is kept, list is still usable.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(reserved, 7));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(reserved));
+}
+
+void test_arl_shrink_reserved_releases_pages(void) {
+  arl_ptr reserved;
+  size_t i, capacity;
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS,
+      arl_create_reserved(&reserved, default_capacity, VALUES_LENGTH));
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(reserved, (int)i));
+  }
+  for (i = 0; i < VALUES_LENGTH - 10; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(reserved, 10, &value));
+  }
+  capacity = reserved->capacity;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_shrink(reserved));
+
+  TEST_ASSERT_EQUAL(capacity, reserved->capacity);
+  TEST_ASSERT_EQUAL(0, resident_pages(reserved, 10, capacity));
+  for (i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(reserved, i, &value));
+    TEST_ASSERT_EQUAL((int)i, value);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(reserved));
+}
+
+void test_arl_shrink_mmap_keeps_file(void) {
+  fill_list(VALUES_LENGTH);
+  arl_clear(l, NULL);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_shrink(l));
+  TEST_ASSERT_EQUAL(_file_size(l->capacity), l->mapping.size);
+}
+
+void test_arl_advise_success(void) {
+  arl_ptr large, heap;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_SUCCESS, arl_create_large(&large, default_capacity, VALUES_LENGTH));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create(&heap, VALUES_LENGTH));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_advise(large, ARL_ADVICE_SEQUENTIAL));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_advise(large, ARL_ADVICE_WILLNEED));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_advise(heap, ARL_ADVICE_RANDOM));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_advise(l, ARL_ADVICE_NORMAL));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS,
+                          arl_advise(heap, (enum arl_advice)42));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(large));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(heap));
+}
+
+/* Serializes list of VALUES_LENGTH elements to the file. */
+void write_serialized_list(void) {
+  arl_ptr heap;
+  size_t i;
+  int fd;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create(&heap, VALUES_LENGTH));
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(heap, (int)i * 5));
+  }
+
+  fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize_fd(heap, fd));
+  close(fd);
+
+  arl_destroy(heap);
+}
+
+void test_arl_open_readonly_reads_mapped_file(void) {
+  arl_ptr first, second;
+  int slice[3], value;
+  size_t i;
+
+  arl_destroy(l);
+  l = NULL;
+  write_serialized_list();
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_open_readonly(&first, file_path));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_open_readonly(&second, file_path));
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arl_length(first));
+  TEST_ASSERT_EQUAL_PTR((char *)first->mapping.address +
+                            sizeof(struct arl_file_header),
+                        first->array);
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(first, i, &value));
+    TEST_ASSERT_EQUAL((int)i * 5, value);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_slice(second, 10, 2, slice));
+  TEST_ASSERT_EQUAL(50, slice[0]);
+  TEST_ASSERT_EQUAL(60, slice[2]);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_advise(second, ARL_ADVICE_SEQUENTIAL));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(first));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(second));
+}
+
+void test_arl_open_readonly_mutators_failure(void) {
+  arl_ptr readonly, clone;
+  int values[2] = {1, 2}, value, holder[3];
+
+  arl_destroy(l);
+  l = NULL;
+  write_serialized_list();
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_open_readonly(&readonly, file_path));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_set(readonly, 0, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_insert(readonly, 0, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_append(readonly, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY,
+                          arl_insert_multi(readonly, 0, 2, values));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_pop(readonly, 0, &value));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY,
+                          arl_pop_multi(readonly, 0, 2, holder));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_remove(readonly, 0, NULL));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_READ_ONLY, arl_clear(readonly, NULL));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS, arl_clone(readonly, &clone));
+
+  // Nothing has changed.
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arl_length(readonly));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(readonly, 1, &value));
+  TEST_ASSERT_EQUAL(5, value);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(readonly));
+}
+
+void test_arl_open_readonly_failure(void) {
+  arl_ptr readonly;
+  FILE *file;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_ARGS,
+                          arl_open_readonly(&readonly, NULL));
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_ERROR_IO, arl_open_readonly(&readonly, "not/existing/list.bin"));
+
+  arl_destroy(l);
+  l = NULL;
+
+  // Header claims more elements than the file holds.
+  write_serialized_list();
+  TEST_ASSERT_EQUAL(0, truncate(file_path, sizeof(struct arl_file_header) + 4));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_FORMAT,
+                          arl_open_readonly(&readonly, file_path));
+
+  file = fopen(file_path, "wb");
+  TEST_ASSERT_NOT_NULL(file);
+  fputs("short", file);
+  fclose(file);
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_FORMAT,
+                          arl_open_readonly(&readonly, file_path));
+}
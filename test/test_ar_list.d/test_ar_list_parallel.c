@@ -0,0 +1,200 @@
+/* Parallel operations tests, meant to be run under ThreadSanitizer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdlib.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH 100003
+
+const size_t default_capacity = 16;
+size_t threads_amounts[] = {1, 2, 3, 4, 7};
+size_t threads_amounts_length = sizeof(threads_amounts) / sizeof(size_t);
+int *expected = NULL;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (arl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  expected = malloc(VALUES_LENGTH * sizeof(int));
+  if (!expected)
+    TEST_FAIL_MESSAGE("Unable to allocate expected values!");
+}
+
+void tearDown(void) {
+  arl_parallel_set_threads(0);
+
+  arl_destroy(l);
+  free(expected);
+
+  l = NULL;
+  expected = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+int compare_ints(const void *a, const void *b) {
+  int a_value = *(const int *)a, b_value = *(const int *)b;
+
+  return (a_value > b_value) - (a_value < b_value);
+}
+
+void fill_list(size_t length) {
+  size_t i;
+
+  arl_clear(l, NULL);
+
+  srand(13);
+  for (i = 0; i < length; i++) {
+    // Small modulo gives many equal values.
+    expected[i] = rand() % 1000 - 500;
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, expected[i]));
+  }
+}
+
+int double_value(int value, void *_) { return value * 2; }
+
+void sum_values(int value, void *sum) {
+  __atomic_add_fetch((long *)sum, value, __ATOMIC_RELAXED);
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_parallel_sort_success(void) {
+  size_t lengths[] = {0, 1, 100, VALUES_LENGTH};
+  size_t i, k;
+
+  for (i = 0; i < threads_amounts_length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                            arl_parallel_set_threads(threads_amounts[i]));
+
+    for (k = 0; k < sizeof(lengths) / sizeof(size_t); k++) {
+      fill_list(lengths[k]);
+      qsort(expected, lengths[k], sizeof(int), compare_ints);
+
+      TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_sort(l, compare_ints));
+      TEST_ASSERT_EQUAL(lengths[k], arl_length(l));
+      if (lengths[k])
+        TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, lengths[k]);
+    }
+  }
+}
+
+void test_arl_parallel_sort_shared_list(void) {
+  arl_ptr clone;
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_set_threads(4));
+  fill_list(VALUES_LENGTH);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_sort(clone, compare_ints));
+
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, VALUES_LENGTH);
+  for (i = 1; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_TRUE(clone->array[i - 1] <= clone->array[i]);
+  }
+
+  arl_destroy(clone);
+}
+
+void test_arl_parallel_map_and_foreach_success(void) {
+  long sum, expected_sum;
+  size_t i, k;
+
+  for (i = 0; i < threads_amounts_length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                            arl_parallel_set_threads(threads_amounts[i]));
+    fill_list(VALUES_LENGTH);
+
+    expected_sum = 0;
+    for (k = 0; k < VALUES_LENGTH; k++) {
+      expected[k] *= 2;
+      expected_sum += expected[k];
+    }
+
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                            arl_parallel_map(l, double_value, NULL));
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, VALUES_LENGTH);
+
+    sum = 0;
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                            arl_parallel_foreach(l, sum_values, &sum));
+    TEST_ASSERT_EQUAL(expected_sum, sum);
+  }
+}
+
+void test_arl_parallel_set_threads_failure(void) {
+  TEST_ASSERT_EQUAL_ERROR(
+      ARL_ERROR_INVALID_ARGS,
+      arl_parallel_set_threads(ARL_PARALLEL_THREADS_MAX + 1));
+}
+
+/*******************************************************************************
+ *    PRIVATE API TESTS
+ ******************************************************************************/
+void test__get_range_covers_array(void) {
+  size_t lengths[] = {1, 15, 16, 17, 1000, VALUES_LENGTH};
+  size_t ranges_amounts[] = {1, 2, 3, 8, 64};
+  size_t i, k, r, start, end, previous_end;
+  int *array = (int *)expected + 1;
+
+  for (i = 0; i < sizeof(lengths) / sizeof(size_t); i++) {
+    for (k = 0; k < sizeof(ranges_amounts) / sizeof(size_t); k++) {
+      previous_end = 0;
+
+      for (r = 0; r < ranges_amounts[k]; r++) {
+        _get_range(array, lengths[i], ranges_amounts[k], r, &start, &end);
+
+        TEST_ASSERT_EQUAL(previous_end, start);
+        TEST_ASSERT_TRUE(start <= end);
+        // Inner boundaries lie on cache lines' boundaries.
+        if (start != 0 && start != lengths[i])
+          TEST_ASSERT_EQUAL(0,
+                            (uintptr_t)(array + start) % ARL_CACHE_LINE_SIZE);
+
+        previous_end = end;
+      }
+
+      TEST_ASSERT_EQUAL(lengths[i], previous_end);
+    }
+  }
+}
+
+void test__co_rank_success(void) {
+  int a_values[] = {1, 3, 3, 5};
+  int b_values[] = {2, 3, 4};
+  // Merged: 1(a) 2(b) 3(a) 3(a) 3(b) 4(b) 5(a)
+  size_t expected_a[] = {0, 1, 1, 2, 3, 3, 3, 4};
+  size_t k;
+
+  for (k = 0; k < sizeof(expected_a) / sizeof(size_t); k++) {
+    TEST_ASSERT_EQUAL(expected_a[k], _co_rank(k, a_values, 4, b_values, 3,
+                                               compare_ints));
+  }
+}
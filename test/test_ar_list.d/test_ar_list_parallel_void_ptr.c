@@ -0,0 +1,107 @@
+/* Parallel operations tests for default `void *` elements.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdlib.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH 10007
+
+const size_t default_capacity = 16;
+int values[VALUES_LENGTH];
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  size_t i;
+
+  if (arl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  srand(13);
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = rand() % 1000 - 500;
+    if (arl_append(l, &values[i]))
+      TEST_FAIL_MESSAGE("Unable to fill list!");
+  }
+}
+
+void tearDown(void) {
+  arl_parallel_set_threads(0);
+
+  arl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+/* Compares pointed integers, gets pointers to the elements. */
+int compare_pointed_ints(const void *a, const void *b) {
+  int a_value = **(int *const *)a, b_value = **(int *const *)b;
+
+  return (a_value > b_value) - (a_value < b_value);
+}
+
+void *next_value(void *value, void *unused) {
+  (void)unused;
+  return (int *)value + 1;
+}
+
+void count_values(void *value, void *count) {
+  (void)value;
+  __atomic_add_fetch((size_t *)count, 1, __ATOMIC_RELAXED);
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_parallel_sort_void_ptr(void) {
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_set_threads(4));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_parallel_sort(l, compare_pointed_ints));
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arl_length(l));
+  for (i = 1; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_TRUE(*(int *)l->array[i - 1] <= *(int *)l->array[i]);
+  }
+}
+
+void test_arl_parallel_map_and_foreach_void_ptr(void) {
+  size_t count = 0, i;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_set_threads(3));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_parallel_map(l, next_value, NULL));
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_PTR(&values[i] + 1, l->array[i]);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_parallel_foreach(l, count_values, &count));
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, count);
+}
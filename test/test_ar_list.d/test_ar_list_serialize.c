@@ -0,0 +1,236 @@
+// Same feature macros as arl_list.c, it is included after system headers.
+#define _GNU_SOURCE
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+// Spans few blocks passed to the callbacks.
+#define VALUES_LENGTH (ARL_FILE_BLOCK_SIZE / sizeof(int) * 2 + 123)
+
+/* In memory stream. */
+struct stream {
+  char *data;
+  size_t size;
+  size_t position;
+  size_t calls;
+};
+
+const char *file_path = "test_ar_list_serialize.bin";
+struct stream stream;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  size_t i;
+
+  memset(&stream, 0, sizeof(stream));
+  stream.data =
+      malloc(sizeof(struct arl_file_header) + VALUES_LENGTH * sizeof(int));
+  if (!stream.data)
+    TEST_FAIL_MESSAGE("Unable to allocate stream!");
+
+  if (arl_create(&l, VALUES_LENGTH))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    if (arl_append(l, (int)i * 7))
+      TEST_FAIL_MESSAGE("Unable to fill list!");
+  }
+}
+
+void tearDown(void) {
+  if (l)
+    arl_destroy(l);
+
+  free(stream.data);
+  remove(file_path);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+size_t stream_write(const void *data, size_t size, void *arg) {
+  struct stream *s = arg;
+
+  memcpy(s->data + s->size, data, size);
+  s->size += size;
+  s->calls++;
+
+  return size;
+}
+
+size_t stream_read(void *data, size_t size, void *arg) {
+  struct stream *s = arg;
+
+  if (size > s->size - s->position)
+    size = s->size - s->position;
+
+  memcpy(data, s->data + s->position, size);
+  s->position += size;
+  s->calls++;
+
+  return size;
+}
+
+size_t failing_write(const void *data, size_t size, void *arg) {
+  (void)data;
+  (void)arg;
+
+  return size / 2;
+}
+
+void TEST_ASSERT_EQUAL_LISTS(arl_ptr expected, arl_ptr received) {
+  TEST_ASSERT_EQUAL(arl_length(expected), arl_length(received));
+  TEST_ASSERT_EQUAL_MEMORY(expected->array, received->array,
+                           arl_length(expected) * sizeof(int));
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_serialize_success(void) {
+  struct arl_file_header *header;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+
+  // Header and three blocks.
+  TEST_ASSERT_EQUAL(4, stream.calls);
+  TEST_ASSERT_EQUAL(sizeof(struct arl_file_header) +
+                        VALUES_LENGTH * sizeof(int),
+                    stream.size);
+
+  header = (struct arl_file_header *)stream.data;
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, _file_header_validate(header));
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, header->length);
+  TEST_ASSERT_TRUE(header->checksum != 0);
+}
+
+void test_arl_deserialize_success(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_deserialize(&restored, stream_read, &stream));
+
+  TEST_ASSERT_EQUAL_LISTS(l, restored);
+  // Single allocation of exact size.
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, restored->capacity);
+  // Restored list is a regular one.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(restored, 1));
+
+  arl_destroy(restored);
+}
+
+void test_arl_deserialize_empty_list_success(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear(l, NULL));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS,
+                          arl_deserialize(&restored, stream_read, &stream));
+
+  TEST_ASSERT_EQUAL(0, arl_length(restored));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(restored, 1));
+
+  arl_destroy(restored);
+}
+
+void test_arl_deserialize_checksum_failure(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+  stream.data[stream.size - 1] ^= 1;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_FORMAT,
+                          arl_deserialize(&restored, stream_read, &stream));
+}
+
+void test_arl_deserialize_truncated_failure(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+  stream.size -= 1;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_IO,
+                          arl_deserialize(&restored, stream_read, &stream));
+}
+
+void test_arl_deserialize_invalid_format_failure(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize(l, stream_write, &stream));
+  ((struct arl_file_header *)stream.data)->type_tag ^= 1;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INVALID_FORMAT,
+                          arl_deserialize(&restored, stream_read, &stream));
+}
+
+void test_arl_serialize_io_failure(void) {
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_IO, arl_serialize(l, failing_write, NULL));
+}
+
+void test_arl_serialize_fd_success(void) {
+  arl_ptr restored;
+  int fd;
+
+  fd = open(file_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  TEST_ASSERT_TRUE(fd >= 0);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize_fd(l, fd));
+  TEST_ASSERT_EQUAL(0, lseek(fd, 0, SEEK_SET));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_deserialize_fd(&restored, fd));
+  close(fd);
+
+  TEST_ASSERT_EQUAL_LISTS(l, restored);
+  arl_destroy(restored);
+}
+
+void test_arl_serialize_fd_mapped_success(void) {
+  arl_ptr mapped;
+  int fd;
+
+  fd = open(file_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  TEST_ASSERT_TRUE(fd >= 0);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_serialize_fd(l, fd));
+  close(fd);
+
+  // Serialized list can be mapped and keeps growing.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create_mmap(&mapped, file_path, 1));
+  TEST_ASSERT_EQUAL_LISTS(l, mapped);
+  TEST_ASSERT_EQUAL(0, ((struct arl_file_header *)mapped->mapping.address)
+                           ->checksum);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(mapped, 1));
+
+  arl_destroy(mapped);
+}
+
+void test_arl_serialize_fd_io_failure(void) {
+  arl_ptr restored;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_IO, arl_serialize_fd(l, -1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_IO, arl_deserialize_fd(&restored, -1));
+}
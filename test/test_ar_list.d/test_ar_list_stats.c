@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+int arl_small_values[] = {0, 1, 2, 3, 4, 5};
+size_t arl_small_length = sizeof(arl_small_values) / sizeof(int);
+const size_t default_capacity = 6;
+arl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (arl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  if (arl_insert_multi(l, 0, arl_small_length, arl_small_values))
+    TEST_FAIL_MESSAGE("Unable to fill list!");
+}
+
+void tearDown(void) {
+  arl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_stats_new_list(void) {
+  struct arl_stats stats;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(l, &stats));
+
+  TEST_ASSERT_EQUAL(0, stats.reallocs);
+  TEST_ASSERT_EQUAL(0, stats.shifted_right);
+  TEST_ASSERT_EQUAL(0, stats.shifted_left);
+  TEST_ASSERT_EQUAL(default_capacity, stats.peak_capacity);
+  TEST_ASSERT_EQUAL(0, stats.wasted_capacity);
+}
+
+void test_arl_stats_growth(void) {
+  struct arl_stats stats;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 6));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(l, &stats));
+
+  // 3 * 6 / 2 + 6
+  TEST_ASSERT_EQUAL(1, stats.reallocs);
+  TEST_ASSERT_EQUAL(15 * sizeof(int), stats.realloc_bytes);
+  TEST_ASSERT_EQUAL(15, stats.peak_capacity);
+  TEST_ASSERT_EQUAL(8, stats.wasted_capacity);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_shrink(l));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(l, &stats));
+
+  TEST_ASSERT_EQUAL(2, stats.reallocs);
+  TEST_ASSERT_EQUAL(22 * sizeof(int), stats.realloc_bytes);
+  TEST_ASSERT_EQUAL(15, stats.peak_capacity);
+  TEST_ASSERT_EQUAL(0, stats.wasted_capacity);
+}
+
+void test_arl_stats_shifts(void) {
+  struct arl_stats stats;
+  int value;
+
+  // Appending and popping the last element does not shift.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, 5, &value));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, 5));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(l, &stats));
+  TEST_ASSERT_EQUAL(0, stats.shifted_right);
+  TEST_ASSERT_EQUAL(0, stats.shifted_left);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, 1, &value));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_insert(l, 0, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(l, &stats));
+  TEST_ASSERT_EQUAL(5, stats.shifted_right);
+  TEST_ASSERT_EQUAL(4, stats.shifted_left);
+}
+
+void test_arl_stats_copy_on_write(void) {
+  struct arl_stats stats;
+  arl_ptr clone;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clone(l, &clone));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(clone, 0, 100));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats(clone, &stats));
+
+  TEST_ASSERT_EQUAL(1, stats.reallocs);
+  TEST_ASSERT_EQUAL(default_capacity * sizeof(int), stats.realloc_bytes);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(clone));
+}
+
+void test_arl_stats_global(void) {
+  struct arl_stats before, after;
+  arl_ptr other;
+  int value;
+
+  arl_stats_global(&before);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_create(&other, 100));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(other, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_insert(other, 0, 0));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_pop(l, 0, &value));
+
+  arl_stats_global(&after);
+  TEST_ASSERT_EQUAL(before.shifted_right + 1, after.shifted_right);
+  TEST_ASSERT_EQUAL(before.shifted_left + 5, after.shifted_left);
+  TEST_ASSERT_EQUAL(before.wasted_capacity + 98 + 1, after.wasted_capacity);
+  TEST_ASSERT_TRUE(after.peak_capacity >= 100);
+
+  // Counters of destroyed list stay, its capacity is not wasted anymore.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_destroy(other));
+  arl_stats_global(&after);
+  TEST_ASSERT_EQUAL(before.shifted_right + 1, after.shifted_right);
+  TEST_ASSERT_EQUAL(before.wasted_capacity + 1, after.wasted_capacity);
+}
+
+void test_arl_stats_dump(void) {
+  char buffer[1024] = {0}, expected[64];
+  FILE *file = tmpfile();
+
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_stats_dump(file));
+
+  rewind(file);
+  TEST_ASSERT_TRUE(fread(buffer, 1, sizeof(buffer) - 1, file) > 0);
+  fclose(file);
+
+  // Only `l` is alive.
+  snprintf(expected, sizeof(expected), "arl %p: length 6", (void *)l);
+  TEST_ASSERT_NOT_NULL(strstr(buffer, expected));
+  TEST_ASSERT_NOT_NULL(strstr(buffer, "arl total: "));
+}
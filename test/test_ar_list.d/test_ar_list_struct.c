@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <string.h>
+
+/* Element big enough to be passed by pointer. */
+struct test_record {
+  int id;
+  char payload[252];
+};
+
+// App
+#include "arl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define RECORDS_LENGTH 50
+
+arl_ptr l = NULL;
+size_t callbacks_amount = 0;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (arl_create(&l, 4))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  callbacks_amount = 0;
+}
+
+void tearDown(void) {
+  arl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arl_error expected, arl_error received) {
+  TEST_ASSERT_EQUAL_STRING(arl_strerror(expected), arl_strerror(received));
+}
+
+struct test_record make_record(int id) {
+  struct test_record record;
+
+  record.id = id;
+  memset(record.payload, 'a' + id % 26, sizeof(record.payload));
+
+  return record;
+}
+
+void TEST_ASSERT_RECORD(int id, size_t i) {
+  struct test_record expected = make_record(id), received;
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_get(l, i, &received));
+  TEST_ASSERT_EQUAL_MEMORY(&expected, &received, sizeof(struct test_record));
+}
+
+void append_records(void) {
+  struct test_record record;
+  int k;
+
+  for (k = 0; k < RECORDS_LENGTH; k++) {
+    record = make_record(k);
+    TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append_ptr(l, &record));
+  }
+}
+
+void count_callback(struct test_record *record) {
+  TEST_ASSERT_EQUAL('a' + record->id % 26, record->payload[0]);
+  callbacks_amount++;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_arl_append_ptr(void) {
+  int k;
+
+  append_records();
+
+  TEST_ASSERT_EQUAL(RECORDS_LENGTH, arl_length(l));
+  for (k = 0; k < RECORDS_LENGTH; k++) {
+    TEST_ASSERT_RECORD(k, (size_t)k);
+  }
+}
+
+void test_arl_set_and_insert_ptr(void) {
+  struct test_record record = make_record(100);
+
+  append_records();
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set_ptr(l, 3, &record));
+  TEST_ASSERT_RECORD(100, 3);
+
+  record = make_record(200);
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_insert_ptr(l, 0, &record));
+  TEST_ASSERT_RECORD(200, 0);
+  TEST_ASSERT_RECORD(0, 1);
+  TEST_ASSERT_RECORD(100, 4);
+  TEST_ASSERT_EQUAL(RECORDS_LENGTH + 1, arl_length(l));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_INDEX_TOO_BIG,
+                          arl_set_ptr(l, RECORDS_LENGTH + 1, &record));
+}
+
+void test_arl_emplace(void) {
+  struct test_record *slot;
+
+  append_records();
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_emplace(l, 10, &slot));
+  *slot = make_record(300);
+  TEST_ASSERT_RECORD(300, 10);
+  TEST_ASSERT_RECORD(10, 11);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_emplace_back(l, &slot));
+  slot->id = 400;
+  memset(slot->payload, 'a' + 400 % 26, sizeof(slot->payload));
+  TEST_ASSERT_RECORD(400, RECORDS_LENGTH + 1);
+  TEST_ASSERT_EQUAL(RECORDS_LENGTH + 2, arl_length(l));
+}
+
+void test_arl_remove_and_clear_ptr(void) {
+  append_records();
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_remove_ptr(l, 0, count_callback));
+  TEST_ASSERT_EQUAL(1, callbacks_amount);
+  TEST_ASSERT_RECORD(1, 0);
+  TEST_ASSERT_EQUAL(RECORDS_LENGTH - 1, arl_length(l));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_clear_ptr(l, count_callback));
+  TEST_ASSERT_EQUAL(RECORDS_LENGTH, callbacks_amount);
+  TEST_ASSERT_EQUAL(0, arl_length(l));
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_POP_EMPTY_LIST,
+                          arl_remove_ptr(l, 0, count_callback));
+}
+
+void test_arl_by_value_functions_stay_available(void) {
+  struct test_record record = make_record(7);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, record));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_insert(l, 0, record));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(l, 1, record));
+  TEST_ASSERT_RECORD(7, 0);
+  TEST_ASSERT_RECORD(7, 1);
+
+  // Rvalues are accepted too.
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_append(l, make_record(8)));
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, arl_set(l, 0, make_record(9)));
+  TEST_ASSERT_RECORD(9, 0);
+  TEST_ASSERT_RECORD(8, 2);
+}
@@ -599,6 +599,48 @@ void test_arl_clear_callback(void) {
   TEST_ASSERT_EQUAL(arl_small_length, free_counter);
 }
 
+void test_arl_shrink_success(void) {
+  arl_error err;
+  arl_ptr l = setup_small_list();
+
+  // Shrinking realloc keeps the array in place.
+  app_realloc_ExpectAndReturn(l->array, arl_small_length * sizeof(void *),
+                              array_memory_mock);
+
+  err = arl_shrink(l);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, err);
+  TEST_ASSERT_EQUAL(arl_small_length, l->capacity);
+  TEST_ASSERT_EQUAL(arl_small_length, l->length);
+  TEST_ASSERT_EQUAL_PTR(&arl_small_values[5], l->array[5]);
+}
+
+void test_arl_shrink_empty_list_success(void) {
+  arl_error err;
+  arl_ptr l = setup_empty_list();
+
+  app_realloc_ExpectAndReturn(l->array, sizeof(void *), array_memory_mock);
+
+  err = arl_shrink(l);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_SUCCESS, err);
+  TEST_ASSERT_EQUAL(1, l->capacity);
+}
+
+void test_arl_shrink_memory_failure(void) {
+  arl_error err;
+  arl_ptr l = setup_small_list();
+
+  app_realloc_ExpectAndReturn(l->array, arl_small_length * sizeof(void *),
+                              NULL);
+
+  err = arl_shrink(l);
+
+  TEST_ASSERT_EQUAL_ERROR(ARL_ERROR_OUT_OF_MEMORY, err);
+  TEST_ASSERT_EQUAL(default_capacity, l->capacity);
+  TEST_ASSERT_EQUAL_PTR(array_memory_mock, l->array);
+}
+
 /*******************************************************************************
  *    PRIVATE API TESTS
  ******************************************************************************/
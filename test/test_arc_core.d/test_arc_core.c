@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// App
+#include "arc_core.c"
+#include "arw_list.h"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH 100
+
+/* Odd sized element, core knows only it's size. */
+struct test_triple {
+  char bytes[3];
+};
+
+arc_ptr l = NULL;
+arw_ptr w = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (arc_create(&l, sizeof(struct test_triple), 0) || arw_create(&w, 2))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  arc_destroy(l);
+  arw_destroy(w);
+
+  l = NULL;
+  w = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(arc_error expected, arc_error received) {
+  TEST_ASSERT_EQUAL_STRING(arc_strerror(expected), arc_strerror(received));
+}
+
+struct test_triple make_triple(int k) {
+  struct test_triple triple;
+
+  triple.bytes[0] = (char)k;
+  triple.bytes[1] = (char)(k + 1);
+  triple.bytes[2] = (char)(k + 2);
+
+  return triple;
+}
+
+void TEST_ASSERT_TRIPLE(int k, size_t i) {
+  struct test_triple expected = make_triple(k), received;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_get(l, i, &received));
+  TEST_ASSERT_EQUAL_MEMORY(&expected, &received, sizeof(struct test_triple));
+}
+
+/*******************************************************************************
+ *    CORE TESTS
+ ******************************************************************************/
+void test_arc_append_and_get(void) {
+  struct test_triple triple;
+  int k;
+
+  for (k = 0; k < VALUES_LENGTH; k++) {
+    triple = make_triple(k);
+    TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_append(l, &triple));
+  }
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, arc_length(l));
+  TEST_ASSERT_EQUAL(sizeof(struct test_triple), arc_elem_size(l));
+  for (k = 0; k < VALUES_LENGTH; k++) {
+    TEST_ASSERT_TRIPLE(k, (size_t)k);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INDEX_TOO_BIG,
+                          arc_get(l, VALUES_LENGTH, &triple));
+}
+
+void test_arc_insert_set_pop(void) {
+  struct test_triple triples[3] = {make_triple(10), make_triple(20),
+                                   make_triple(30)};
+  struct test_triple triple;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_insert_multi(l, 0, 3, triples));
+  triple = make_triple(15);
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_insert(l, 1, &triple));
+  TEST_ASSERT_TRIPLE(10, 0);
+  TEST_ASSERT_TRIPLE(15, 1);
+  TEST_ASSERT_TRIPLE(20, 2);
+  TEST_ASSERT_TRIPLE(30, 3);
+
+  triple = make_triple(40);
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_set(l, 3, &triple));
+  TEST_ASSERT_TRIPLE(40, 3);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_pop(l, 0, &triple));
+  TEST_ASSERT_EQUAL_MEMORY(&triples[0], &triple, sizeof(struct test_triple));
+  TEST_ASSERT_TRIPLE(15, 0);
+
+  // Index bigger than length pops the last one.
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_pop(l, 100, NULL));
+  TEST_ASSERT_EQUAL(2, arc_length(l));
+  TEST_ASSERT_TRIPLE(20, 1);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_clear(l));
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_POP_EMPTY_LIST, arc_pop(l, 0, NULL));
+}
+
+void test_arc_emplace_and_at(void) {
+  struct test_triple triple = make_triple(1);
+  void *slot;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_append(l, &triple));
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_emplace(l, 0, &slot));
+  triple = make_triple(2);
+  memcpy(slot, &triple, sizeof(triple));
+
+  TEST_ASSERT_TRIPLE(2, 0);
+  TEST_ASSERT_TRIPLE(1, 1);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_at(l, 1, &slot));
+  TEST_ASSERT_EQUAL(1, ((struct test_triple *)slot)->bytes[0]);
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INDEX_TOO_BIG, arc_at(l, 2, &slot));
+}
+
+void test_arc_create_failure(void) {
+  arc_ptr failed;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INVALID_ARGS, arc_create(&failed, 0, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_OVERFLOW,
+                          arc_create(&failed, 2, ARC_SIZE_T_MAX));
+}
+
+void test_arc_create_sized_aligns_elements(void) {
+  char record[13], received[13];
+  arc_ptr sized;
+  void *slot;
+  size_t i, k;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_create_sized(&sized, 13, 64, 1));
+  TEST_ASSERT_EQUAL(13, arc_elem_size(sized));
+  TEST_ASSERT_EQUAL(64, arc_stride(sized));
+
+  // Growth reallocates a few times, elements keep alignment and values.
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    memset(record, (int)i, sizeof(record));
+    TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_insert(sized, 0, record));
+
+    for (k = 0; k <= i; k++) {
+      TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_at(sized, k, &slot));
+      TEST_ASSERT_EQUAL(0, (uintptr_t)slot % 64);
+    }
+  }
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    memset(record, (int)(VALUES_LENGTH - 1 - i), sizeof(record));
+    TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arc_get(sized, i, received));
+    TEST_ASSERT_EQUAL_MEMORY(record, received, sizeof(record));
+  }
+
+  arc_destroy(sized);
+}
+
+void test_arc_create_sized_failure(void) {
+  arc_ptr failed;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INVALID_ARGS,
+                          arc_create_sized(&failed, 8, 0, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INVALID_ARGS,
+                          arc_create_sized(&failed, 8, 24, 1));
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_OVERFLOW,
+                          arc_create_sized(&failed, ARC_SIZE_T_MAX, 2, 1));
+}
+
+/*******************************************************************************
+ *    WRAPPER TESTS
+ ******************************************************************************/
+void test_arw_typed_operations(void) {
+  ARW_VALUE_TYPE value;
+  int k;
+
+  for (k = 0; k < VALUES_LENGTH; k++) {
+    TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_append(w, k));
+  }
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_insert(w, 0, -1));
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_set(w, 1, -2));
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH + 1, arw_length(w));
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_get(w, 0, &value));
+  TEST_ASSERT_EQUAL(-1, value);
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_get(w, 1, &value));
+  TEST_ASSERT_EQUAL(-2, value);
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_get(w, VALUES_LENGTH, &value));
+  TEST_ASSERT_EQUAL(VALUES_LENGTH - 1, value);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_pop(w, 0, &value));
+  TEST_ASSERT_EQUAL(-1, value);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_ERROR_INDEX_TOO_BIG,
+                          arw_set(w, VALUES_LENGTH, 0));
+  TEST_ASSERT_EQUAL_STRING("Index too big",
+                           arw_strerror(ARC_ERROR_INDEX_TOO_BIG));
+}
+
+void test_arw_insert_multi(void) {
+  ARW_VALUE_TYPE values[] = {1, 2, 3}, value;
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_append(w, 4));
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_insert_multi(w, 0, 3, values));
+
+  TEST_ASSERT_EQUAL(4, arw_length(w));
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_get(w, 3, &value));
+  TEST_ASSERT_EQUAL(4, value);
+
+  TEST_ASSERT_EQUAL_ERROR(ARC_SUCCESS, arw_clear(w));
+  TEST_ASSERT_EQUAL(0, arw_length(w));
+}
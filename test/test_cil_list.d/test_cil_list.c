@@ -0,0 +1,196 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdint.h>
+
+// App
+#include "cil_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH (CIL_BLOCK_LENGTH * 40 + 17)
+
+CIL_VALUE_TYPE values[VALUES_LENGTH];
+cil_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (cil_create(&l))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  cil_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(cil_error expected, cil_error received) {
+  TEST_ASSERT_EQUAL_STRING(cil_strerror(expected), cil_strerror(received));
+}
+
+/* Appends values and checks them by get and by block decoding.
+ */
+void append_and_check(void) {
+  CIL_VALUE_TYPE block[CIL_BLOCK_LENGTH], value;
+  size_t i, block_i, values_amount;
+
+  TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS,
+                          cil_append_multi(l, VALUES_LENGTH, values));
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, cil_length(l));
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS, cil_get(l, i, &value));
+    TEST_ASSERT_TRUE(values[i] == value);
+  }
+
+  TEST_ASSERT_EQUAL(VALUES_LENGTH / CIL_BLOCK_LENGTH + 1,
+                    cil_blocks_amount(l));
+  for (block_i = 0, i = 0; block_i < cil_blocks_amount(l); block_i++) {
+    TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS,
+                            cil_decode_block(l, block_i, block,
+                                             &values_amount));
+    TEST_ASSERT_EQUAL_MEMORY(&values[i], block,
+                             values_amount * sizeof(CIL_VALUE_TYPE));
+    i += values_amount;
+  }
+  TEST_ASSERT_EQUAL(VALUES_LENGTH, i);
+}
+
+void sum_callback(CIL_VALUE_TYPE value, void *arg) {
+  *(CIL_VALUE_TYPE *)arg += value;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_cil_sorted_ids_use_delta(void) {
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = 1000000000000 + (CIL_VALUE_TYPE)(i * 3 + i % 2);
+  }
+
+  append_and_check();
+
+  for (i = 0; i < l->blocks_length; i++) {
+    TEST_ASSERT_EQUAL(CIL_ENCODING_DELTA, l->blocks[i].encoding);
+    TEST_ASSERT_TRUE(l->blocks[i].bits <= 3);
+  }
+
+  // 8 bytes per value in plain array.
+  TEST_ASSERT_TRUE(cil_memory_usage(l) * 4 < VALUES_LENGTH * 8);
+}
+
+void test_cil_unsorted_values_use_frame_of_reference(void) {
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = 5000 + (CIL_VALUE_TYPE)((i * 7919) % 1000);
+  }
+
+  append_and_check();
+
+  for (i = 0; i < l->blocks_length; i++) {
+    TEST_ASSERT_EQUAL(CIL_ENCODING_FOR, l->blocks[i].encoding);
+    TEST_ASSERT_EQUAL(10, l->blocks[i].bits);
+  }
+}
+
+void test_cil_constant_values_take_no_bits(void) {
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = 42;
+  }
+
+  append_and_check();
+
+  TEST_ASSERT_EQUAL(0, l->blocks[0].bits);
+  TEST_ASSERT_EQUAL(0, l->words_length);
+}
+
+void test_cil_extreme_values(void) {
+  size_t i;
+
+  // Full 64 bit range, values cross words' boundaries.
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = i % 2 ? INT64_MAX - (CIL_VALUE_TYPE)i
+                      : INT64_MIN + (CIL_VALUE_TYPE)i;
+  }
+
+  append_and_check();
+
+  TEST_ASSERT_EQUAL(64, l->blocks[0].bits);
+}
+
+void test_cil_negative_values(void) {
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = -1000 + (CIL_VALUE_TYPE)(i % 300) - (CIL_VALUE_TYPE)(i % 7);
+  }
+
+  append_and_check();
+}
+
+void test_cil_foreach(void) {
+  CIL_VALUE_TYPE sum = 0, expected = 0;
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[i] = (CIL_VALUE_TYPE)i;
+    expected += values[i];
+  }
+  TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS,
+                          cil_append_multi(l, VALUES_LENGTH, values));
+
+  TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS, cil_foreach(l, sum_callback, &sum));
+  TEST_ASSERT_TRUE(expected == sum);
+
+  TEST_ASSERT_EQUAL_ERROR(CIL_ERROR_INVALID_ARGS, cil_foreach(l, NULL, NULL));
+}
+
+void test_cil_index_too_big_failure(void) {
+  CIL_VALUE_TYPE value, block[CIL_BLOCK_LENGTH];
+  size_t values_amount;
+
+  TEST_ASSERT_EQUAL_ERROR(CIL_ERROR_INDEX_TOO_BIG, cil_get(l, 0, &value));
+  TEST_ASSERT_EQUAL_ERROR(CIL_ERROR_INDEX_TOO_BIG,
+                          cil_decode_block(l, 0, block, &values_amount));
+
+  TEST_ASSERT_EQUAL_ERROR(CIL_SUCCESS, cil_append(l, 1));
+  TEST_ASSERT_EQUAL_ERROR(CIL_ERROR_INDEX_TOO_BIG, cil_get(l, 1, &value));
+  TEST_ASSERT_EQUAL_ERROR(CIL_ERROR_INDEX_TOO_BIG,
+                          cil_decode_block(l, 1, block, &values_amount));
+}
+
+/*******************************************************************************
+ *    PRIVATE API TESTS
+ ******************************************************************************/
+void test__bits_width(void) {
+  TEST_ASSERT_EQUAL(0, _bits_width(0));
+  TEST_ASSERT_EQUAL(1, _bits_width(1));
+  TEST_ASSERT_EQUAL(8, _bits_width(255));
+  TEST_ASSERT_EQUAL(9, _bits_width(256));
+  TEST_ASSERT_EQUAL(64, _bits_width(UINT64_MAX));
+}
+
+void test__unpack_crossing_words(void) {
+  uint64_t words[2] = {(uint64_t)0x5 << 61, 0x3};
+
+  TEST_ASSERT_EQUAL(0x1d, _unpack(words, 61, 5));
+  TEST_ASSERT_EQUAL(0, _unpack(words, 3, 0));
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "mpq_queue.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+const size_t default_capacity = 8;
+mpq_ptr q = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  mpq_error err;
+
+  err = mpq_create(&q, default_capacity);
+  if (err)
+    TEST_FAIL_MESSAGE("Unable to create queue!");
+}
+
+void tearDown(void) {
+  mpq_destroy(q);
+
+  q = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(mpq_error expected, mpq_error received) {
+  TEST_ASSERT_EQUAL_STRING(mpq_strerror(expected), mpq_strerror(received));
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_mpq_create_invalid_args(void) {
+  mpq_ptr local_q;
+
+  TEST_ASSERT_EQUAL_ERROR(MPQ_ERROR_INVALID_ARGS, mpq_create(&local_q, 0));
+}
+
+void test_mpq_create_capacity_rounding(void) {
+  size_t requested[] = {1, 2, 3, 5, 8, 9, 1000};
+  size_t expected[] = {2, 2, 4, 8, 8, 16, 1024};
+  mpq_ptr local_q;
+  mpq_error err;
+  size_t i;
+
+  for (i = 0; i < sizeof(requested) / sizeof(size_t); i++) {
+    err = mpq_create(&local_q, requested[i]);
+
+    TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, err);
+    TEST_ASSERT_EQUAL(expected[i], mpq_capacity(local_q));
+
+    mpq_destroy(local_q);
+  }
+}
+
+void test_mpq_create_overflow(void) {
+  mpq_ptr local_q;
+
+  TEST_ASSERT_EQUAL_ERROR(MPQ_ERROR_OVERFLOW,
+                          mpq_create(&local_q, MPQ_SIZE_T_MAX));
+}
+
+void test_mpq_pop_empty(void) {
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(MPQ_ERROR_QUEUE_EMPTY, mpq_pop(q, &value));
+  TEST_ASSERT_EQUAL(0, mpq_length(q));
+}
+
+void test_mpq_push_full(void) {
+  size_t i;
+
+  for (i = 0; i < default_capacity; i++) {
+    TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, mpq_push(q, (int)i));
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(MPQ_ERROR_QUEUE_FULL, mpq_push(q, -1));
+  TEST_ASSERT_EQUAL(default_capacity, mpq_length(q));
+}
+
+void test_mpq_push_pop_fifo_order(void) {
+  int values[] = {5, 4, 3, 2, 1};
+  size_t values_len = sizeof(values) / sizeof(int);
+  int value;
+  size_t i;
+
+  for (i = 0; i < values_len; i++) {
+    TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, mpq_push(q, values[i]));
+  }
+
+  TEST_ASSERT_EQUAL(values_len, mpq_length(q));
+
+  for (i = 0; i < values_len; i++) {
+    TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, mpq_pop(q, &value));
+    TEST_ASSERT_EQUAL(values[i], value);
+  }
+
+  TEST_ASSERT_EQUAL(0, mpq_length(q));
+}
+
+void test_mpq_push_pop_wrap_around(void) {
+  const size_t laps = 5;
+  int value, expected = 0, pushed = 0;
+  size_t i, lap;
+
+  // Keep queue half filled so positions wrap around many times.
+  for (lap = 0; lap < laps * default_capacity; lap++) {
+    for (i = 0; i < default_capacity / 2; i++) {
+      TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, mpq_push(q, pushed++));
+    }
+    for (i = 0; i < default_capacity / 2; i++) {
+      TEST_ASSERT_EQUAL_ERROR(MPQ_SUCCESS, mpq_pop(q, &value));
+      TEST_ASSERT_EQUAL(expected++, value);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(MPQ_ERROR_QUEUE_EMPTY, mpq_pop(q, &value));
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS TESTS
+ ******************************************************************************/
+void test_mpq_errors_string_matching(void) {
+  TEST_ASSERT_EQUAL_MESSAGE(
+      MPQ_ERROR_LEN, MPQ_ERROR_STRINGS_LEN,
+      "Each error needs to have matching pair in MPQ_ERROR_STRINGS.");
+}
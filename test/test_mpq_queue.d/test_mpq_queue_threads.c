@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <stddef.h>
+
+// App
+#include "mpq_queue.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define PRODUCERS_AMOUNT 4
+#define CONSUMERS_AMOUNT 4
+#define VALUES_PER_PRODUCER 10000
+
+const size_t default_capacity = 64;
+mpq_ptr q = NULL;
+
+struct consumer_result {
+  long long sum;
+  size_t count;
+};
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  mpq_error err;
+
+  err = mpq_create(&q, default_capacity);
+  if (err)
+    TEST_FAIL_MESSAGE("Unable to create queue!");
+}
+
+void tearDown(void) {
+  mpq_destroy(q);
+
+  q = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void *producer(void *arg) {
+  int first = *(int *)arg;
+  int i;
+
+  for (i = first; i < first + VALUES_PER_PRODUCER; i++) {
+    while (mpq_push(q, i) == MPQ_ERROR_QUEUE_FULL)
+      ;
+  }
+
+  return NULL;
+}
+
+void *consumer(void *arg) {
+  struct consumer_result *result = arg;
+  size_t total = PRODUCERS_AMOUNT * VALUES_PER_PRODUCER / CONSUMERS_AMOUNT;
+  int value;
+
+  while (result->count < total) {
+    if (mpq_pop(q, &value) == MPQ_SUCCESS) {
+      result->sum += value;
+      result->count++;
+    }
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_mpq_many_producers_many_consumers(void) {
+  struct consumer_result results[CONSUMERS_AMOUNT] = {0};
+  pthread_t producers[PRODUCERS_AMOUNT], consumers[CONSUMERS_AMOUNT];
+  int firsts[PRODUCERS_AMOUNT];
+  long long expected_sum = 0, received_sum = 0;
+  size_t received_count = 0;
+  long long n = PRODUCERS_AMOUNT * (long long)VALUES_PER_PRODUCER;
+  int i, value;
+
+  // Every value from 0 till n is pushed exactly once.
+  expected_sum = n * (n - 1) / 2;
+
+  for (i = 0; i < CONSUMERS_AMOUNT; i++) {
+    pthread_create(&consumers[i], NULL, consumer, &results[i]);
+  }
+  for (i = 0; i < PRODUCERS_AMOUNT; i++) {
+    firsts[i] = i * VALUES_PER_PRODUCER;
+    pthread_create(&producers[i], NULL, producer, &firsts[i]);
+  }
+
+  for (i = 0; i < PRODUCERS_AMOUNT; i++) {
+    pthread_join(producers[i], NULL);
+  }
+  for (i = 0; i < CONSUMERS_AMOUNT; i++) {
+    pthread_join(consumers[i], NULL);
+    received_sum += results[i].sum;
+    received_count += results[i].count;
+  }
+
+  TEST_ASSERT_EQUAL(n, received_count);
+  TEST_ASSERT_EQUAL(expected_sum, received_sum);
+  TEST_ASSERT_EQUAL(MPQ_ERROR_QUEUE_EMPTY, mpq_pop(q, &value));
+}
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+#include <stdlib.h>
+
+// App
+#include "rle_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define VALUES_LENGTH 2000
+
+RLE_VALUE_TYPE values[VALUES_LENGTH], expanded[VALUES_LENGTH];
+size_t values_length = 0;
+rle_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (rle_create(&l))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  values_length = 0;
+}
+
+void tearDown(void) {
+  rle_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(rle_error expected, rle_error received) {
+  TEST_ASSERT_EQUAL_STRING(rle_strerror(expected), rle_strerror(received));
+}
+
+/* Checks list against plain array of expected values, element by element,
+ *  by expansion and by runs. Neighbour runs never have equal values.
+ */
+void check_list(void) {
+  RLE_VALUE_TYPE value, previous = 0;
+  size_t i, run_i, run_length, total = 0;
+
+  TEST_ASSERT_EQUAL(values_length, rle_length(l));
+
+  for (i = 0; i < values_length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_get(l, i, &value));
+    TEST_ASSERT_EQUAL(values[i], value);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_expand(l, expanded));
+  TEST_ASSERT_EQUAL_INT_ARRAY(values, expanded, values_length);
+
+  for (run_i = 0; run_i < rle_runs_amount(l); run_i++) {
+    TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS,
+                            rle_get_run(l, run_i, &value, &run_length));
+    TEST_ASSERT_TRUE(run_length > 0);
+    if (run_i)
+      TEST_ASSERT_TRUE(value != previous);
+
+    previous = value;
+    total += run_length;
+  }
+  TEST_ASSERT_EQUAL(values_length, total);
+}
+
+void insert_expected(size_t i, RLE_VALUE_TYPE value) {
+  if (i > values_length)
+    i = values_length;
+
+  memmove(&values[i + 1], &values[i],
+          (values_length - i) * sizeof(RLE_VALUE_TYPE));
+  values[i] = value;
+  values_length++;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_rle_append_merges_runs(void) {
+  size_t i;
+
+  for (i = 0; i < 100; i++) {
+    values[values_length++] = (int)(i / 10);
+    TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append(l, (int)(i / 10)));
+  }
+
+  check_list();
+  TEST_ASSERT_EQUAL(10, rle_runs_amount(l));
+}
+
+void test_rle_append_run(void) {
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 7, 300));
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 7, 20));
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, -1, 5));
+  for (i = 0; i < 320; i++) {
+    values[values_length++] = 7;
+  }
+  for (i = 0; i < 5; i++) {
+    values[values_length++] = -1;
+  }
+
+  check_list();
+  TEST_ASSERT_EQUAL(2, rle_runs_amount(l));
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INVALID_ARGS, rle_append_run(l, 1, 0));
+}
+
+void test_rle_insert_split_and_merge(void) {
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 1, 10));
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 2, 10));
+  for (i = 0; i < 20; i++) {
+    values[values_length++] = i < 10 ? 1 : 2;
+  }
+
+  // Split of the first run.
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, 4, 3));
+  insert_expected(4, 3);
+  check_list();
+  TEST_ASSERT_EQUAL(4, rle_runs_amount(l));
+
+  // Equal to the run under the index.
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, 4, 3));
+  insert_expected(4, 3);
+  check_list();
+  TEST_ASSERT_EQUAL(4, rle_runs_amount(l));
+
+  // Equal to the previous run, at run's start.
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, 12, 1));
+  insert_expected(12, 1);
+  check_list();
+  TEST_ASSERT_EQUAL(4, rle_runs_amount(l));
+
+  // New run at run's start.
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, 0, 9));
+  insert_expected(0, 9);
+  check_list();
+  TEST_ASSERT_EQUAL(5, rle_runs_amount(l));
+
+  // Index bigger than length appends.
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, 1000, 2));
+  insert_expected(1000, 2);
+  check_list();
+  TEST_ASSERT_EQUAL(5, rle_runs_amount(l));
+}
+
+void test_rle_insert_random(void) {
+  RLE_VALUE_TYPE value;
+  size_t i, k;
+
+  srand(13);
+  for (k = 0; k < VALUES_LENGTH - 1; k++) {
+    i = (size_t)rand() % (values_length + 2);
+    value = rand() % 3;
+
+    TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_insert(l, i, value));
+    insert_expected(i, value);
+  }
+
+  check_list();
+}
+
+void test_rle_slice(void) {
+  RLE_VALUE_TYPE slice[VALUES_LENGTH];
+  size_t i;
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    values[values_length++] = (int)(i / 7 % 5);
+    TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append(l, values[i]));
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_slice(l, 13, 100, slice));
+  TEST_ASSERT_EQUAL_INT_ARRAY(&values[13], slice, 100);
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS,
+                          rle_slice(l, 0, VALUES_LENGTH, slice));
+  TEST_ASSERT_EQUAL_INT_ARRAY(values, slice, VALUES_LENGTH);
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INVALID_ARGS,
+                          rle_slice(l, 1, VALUES_LENGTH, slice));
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INDEX_TOO_BIG,
+                          rle_slice(l, VALUES_LENGTH, 1, slice));
+}
+
+void test_rle_index_too_big_failure(void) {
+  RLE_VALUE_TYPE value;
+  size_t run_length;
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INDEX_TOO_BIG, rle_get(l, 0, &value));
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INDEX_TOO_BIG,
+                          rle_get_run(l, 0, &value, &run_length));
+
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append(l, 1));
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INDEX_TOO_BIG, rle_get(l, 1, &value));
+  TEST_ASSERT_EQUAL_ERROR(RLE_ERROR_INDEX_TOO_BIG,
+                          rle_get_run(l, 1, &value, &run_length));
+}
+
+void test_rle_memory_usage(void) {
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 1, 1000000));
+
+  TEST_ASSERT_TRUE(rle_memory_usage(l) < 1000);
+}
+
+/*******************************************************************************
+ *    PRIVATE API TESTS
+ ******************************************************************************/
+void test__find_run(void) {
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 1, 3));
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 2, 1));
+  TEST_ASSERT_EQUAL_ERROR(RLE_SUCCESS, rle_append_run(l, 3, 5));
+
+  TEST_ASSERT_EQUAL(0, _find_run(l, 0));
+  TEST_ASSERT_EQUAL(0, _find_run(l, 2));
+  TEST_ASSERT_EQUAL(1, _find_run(l, 3));
+  TEST_ASSERT_EQUAL(2, _find_run(l, 4));
+  TEST_ASSERT_EQUAL(2, _find_run(l, 8));
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "sgl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+const size_t first_segment_capacity = 4;
+sgl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (sgl_create(&l, first_segment_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  sgl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(sgl_error expected, sgl_error received) {
+  TEST_ASSERT_EQUAL_STRING(sgl_strerror(expected), sgl_strerror(received));
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_sgl_create_failure(void) {
+  sgl_ptr local_l;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_INVALID_ARGS, sgl_create(&local_l, 0));
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_OVERFLOW,
+                          sgl_create(&local_l, SGL_SIZE_T_MAX));
+}
+
+void test_sgl_create_rounds_first_segment(void) {
+  sgl_ptr local_l;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_create(&local_l, 5));
+  TEST_ASSERT_EQUAL(8, _segment_capacity(local_l, 0));
+  TEST_ASSERT_EQUAL(16, _segment_capacity(local_l, 1));
+  TEST_ASSERT_EQUAL(0, sgl_length(local_l));
+
+  sgl_destroy(local_l);
+}
+
+void test_sgl_locate(void) {
+  size_t indexes[] = {0, 3, 4, 11, 12, 27, 28};
+  size_t segments[] = {0, 0, 1, 1, 2, 2, 3};
+  size_t offsets[] = {0, 3, 0, 7, 0, 15, 0};
+  size_t i, segment_i, offset;
+
+  for (i = 0; i < sizeof(indexes) / sizeof(size_t); i++) {
+    _locate(l, indexes[i], &segment_i, &offset);
+
+    TEST_ASSERT_EQUAL(segments[i], segment_i);
+    TEST_ASSERT_EQUAL(offsets[i], offset);
+  }
+}
+
+void test_sgl_append_and_get(void) {
+  const size_t values_amount = 100;
+  size_t i;
+  int value;
+
+  for (i = 0; i < values_amount; i++) {
+    TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_append(l, (int)i));
+  }
+
+  TEST_ASSERT_EQUAL(values_amount, sgl_length(l));
+
+  for (i = 0; i < values_amount; i++) {
+    TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_get(l, i, &value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_INDEX_TOO_BIG,
+                          sgl_get(l, values_amount, &value));
+}
+
+void test_sgl_append_multi_spans_segments(void) {
+  int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
+  size_t values_len = sizeof(values) / sizeof(int);
+  size_t i;
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_append(l, -1));
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_append_multi(l, values_len, values));
+
+  TEST_ASSERT_EQUAL(values_len + 1, sgl_length(l));
+  TEST_ASSERT_NOT_NULL(l->segments[2]);
+  TEST_ASSERT_NULL(l->segments[3]);
+
+  for (i = 0; i < values_len; i++) {
+    TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_get(l, i + 1, &value));
+    TEST_ASSERT_EQUAL(values[i], value);
+  }
+}
+
+void test_sgl_pointers_are_stable(void) {
+  int *first, *first_again;
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_append(l, 42));
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_get_ptr(l, 0, &first));
+
+  for (i = 0; i < 1000; i++) {
+    TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_append(l, (int)i));
+  }
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_get_ptr(l, 0, &first_again));
+  TEST_ASSERT_EQUAL_PTR(first, first_again);
+  TEST_ASSERT_EQUAL(42, *first);
+}
+
+void test_sgl_append_failed_list(void) {
+  l->failed = 1;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_LIST_FAILED, sgl_append(l, 1));
+}
+
+void test_sgl_append_multi_overflow_fails_list(void) {
+  int values[] = {1, 2};
+
+  l->reserved = SGL_SIZE_T_MAX - 1;
+
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_OVERFLOW, sgl_append_multi(l, 2, values));
+  TEST_ASSERT_EQUAL_ERROR(SGL_ERROR_LIST_FAILED, sgl_append(l, 3));
+  TEST_ASSERT_EQUAL(0, sgl_length(l));
+
+  l->reserved = 0;
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS TESTS
+ ******************************************************************************/
+void test_sgl_errors_string_matching(void) {
+  TEST_ASSERT_EQUAL_MESSAGE(
+      SGL_ERROR_LEN, SGL_ERROR_STRINGS_LEN,
+      "Each error needs to have matching pair in SGL_ERROR_STRINGS.");
+}
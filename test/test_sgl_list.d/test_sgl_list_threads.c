@@ -0,0 +1,141 @@
+/* Stress tests, meant to be run under ThreadSanitizer.
+ *
+ * Writers append batches tagged with writer's id and batch's number, readers
+ *  walk published part of the list without any lock.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+
+// App
+#include "sgl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define WRITERS_AMOUNT 4
+#define READERS_AMOUNT 2
+#define BATCH_LEN 3
+#define ITERATIONS 3000
+// Value encodes writer and batch, ex. 3000123 is writer 3, batch 123.
+#define WRITER_MULTIPLIER 1000000
+
+sgl_ptr l = NULL;
+volatile int writers_done = 0;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  writers_done = 0;
+
+  if (sgl_create(&l, 1))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  sgl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(sgl_error expected, sgl_error received) {
+  TEST_ASSERT_EQUAL_STRING(sgl_strerror(expected), sgl_strerror(received));
+}
+
+void *writer(void *arg) {
+  int id = *(int *)arg, batch[BATCH_LEN];
+  size_t i, k;
+
+  for (i = 0; i < ITERATIONS; i++) {
+    for (k = 0; k < BATCH_LEN; k++) {
+      batch[k] = id * WRITER_MULTIPLIER + (int)i;
+    }
+
+    if (i % 2)
+      sgl_append_multi(l, BATCH_LEN, batch);
+    else
+      for (k = 0; k < BATCH_LEN; k++)
+        sgl_append(l, batch[k]);
+  }
+
+  return NULL;
+}
+
+void *reader(void *arg) {
+  size_t *invalid_values = arg, i, length;
+  int value;
+
+  while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+    length = sgl_length(l);
+
+    for (i = 0; i < length; i++) {
+      if (sgl_get(l, i, &value) ||
+          value % WRITER_MULTIPLIER >= ITERATIONS ||
+          value / WRITER_MULTIPLIER >= WRITERS_AMOUNT)
+        (*invalid_values)++;
+    }
+
+    sched_yield();
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_sgl_concurrent_appends(void) {
+  pthread_t writers[WRITERS_AMOUNT], readers[READERS_AMOUNT];
+  size_t invalid_values[READERS_AMOUNT] = {0};
+  size_t counts[WRITERS_AMOUNT][ITERATIONS] = {{0}};
+  int ids[WRITERS_AMOUNT], value;
+  size_t i, k;
+
+  for (i = 0; i < READERS_AMOUNT; i++) {
+    pthread_create(&readers[i], NULL, reader, &invalid_values[i]);
+  }
+  for (i = 0; i < WRITERS_AMOUNT; i++) {
+    ids[i] = (int)i;
+    pthread_create(&writers[i], NULL, writer, &ids[i]);
+  }
+
+  for (i = 0; i < WRITERS_AMOUNT; i++) {
+    pthread_join(writers[i], NULL);
+  }
+
+  __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+
+  for (i = 0; i < READERS_AMOUNT; i++) {
+    pthread_join(readers[i], NULL);
+    TEST_ASSERT_EQUAL(0, invalid_values[i]);
+  }
+
+  TEST_ASSERT_EQUAL(WRITERS_AMOUNT * ITERATIONS * BATCH_LEN, sgl_length(l));
+
+  for (i = 0; i < sgl_length(l); i++) {
+    TEST_ASSERT_EQUAL_ERROR(SGL_SUCCESS, sgl_get(l, i, &value));
+    counts[value / WRITER_MULTIPLIER][value % WRITER_MULTIPLIER]++;
+  }
+
+  // Every value was appended exactly `BATCH_LEN` times.
+  for (i = 0; i < WRITERS_AMOUNT; i++) {
+    for (k = 0; k < ITERATIONS; k++) {
+      TEST_ASSERT_EQUAL(BATCH_LEN, counts[i][k]);
+    }
+  }
+}
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "soa_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define ROWS_LENGTH 100
+
+soa_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (soa_create(&l, 0))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  soa_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(soa_error expected, soa_error received) {
+  TEST_ASSERT_EQUAL_STRING(soa_strerror(expected), soa_strerror(received));
+}
+
+struct soa_row make_row(int key) {
+  struct soa_row row;
+
+  row.key = key;
+  row.value = key * 0.5;
+
+  return row;
+}
+
+void append_rows(void) {
+  struct soa_row row;
+  int k;
+
+  for (k = 0; k < ROWS_LENGTH; k++) {
+    row = make_row(k);
+    TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_append(l, &row));
+  }
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_soa_append_and_get(void) {
+  struct soa_row row;
+  int k;
+
+  append_rows();
+
+  TEST_ASSERT_EQUAL(ROWS_LENGTH, soa_length(l));
+  for (k = 0; k < ROWS_LENGTH; k++) {
+    TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_get(l, (size_t)k, &row));
+    TEST_ASSERT_EQUAL(k, row.key);
+    TEST_ASSERT_TRUE(k * 0.5 == row.value);
+  }
+}
+
+void test_soa_views_are_columns(void) {
+  const int *keys;
+  const double *values;
+  int k;
+
+  append_rows();
+
+  keys = soa_view_key(l);
+  values = soa_view_value(l);
+  for (k = 0; k < ROWS_LENGTH; k++) {
+    TEST_ASSERT_EQUAL(k, keys[k]);
+    TEST_ASSERT_TRUE(k * 0.5 == values[k]);
+  }
+}
+
+void test_soa_field_get_set(void) {
+  double value;
+  int key;
+
+  append_rows();
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_set_value(l, 10, -1.0));
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_get_value(l, 10, &value));
+  TEST_ASSERT_TRUE(-1.0 == value);
+
+  // Other field is untouched.
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_get_key(l, 10, &key));
+  TEST_ASSERT_EQUAL(10, key);
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_ERROR_INDEX_TOO_BIG,
+                          soa_get_key(l, ROWS_LENGTH, &key));
+  TEST_ASSERT_EQUAL_ERROR(SOA_ERROR_INDEX_TOO_BIG,
+                          soa_set_key(l, ROWS_LENGTH, 1));
+}
+
+void test_soa_insert_moves_all_columns(void) {
+  struct soa_row row = make_row(-7);
+
+  append_rows();
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_insert(l, 5, &row));
+  TEST_ASSERT_EQUAL(ROWS_LENGTH + 1, soa_length(l));
+
+  TEST_ASSERT_EQUAL(4, soa_view_key(l)[4]);
+  TEST_ASSERT_EQUAL(-7, soa_view_key(l)[5]);
+  TEST_ASSERT_EQUAL(5, soa_view_key(l)[6]);
+  TEST_ASSERT_TRUE(-3.5 == soa_view_value(l)[5]);
+  TEST_ASSERT_TRUE(2.5 == soa_view_value(l)[6]);
+
+  // Index bigger than length appends.
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_insert(l, 1000, &row));
+  TEST_ASSERT_EQUAL(-7, soa_view_key(l)[ROWS_LENGTH + 1]);
+}
+
+void test_soa_set_and_pop(void) {
+  struct soa_row row = make_row(-7);
+
+  append_rows();
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_set(l, 0, &row));
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_pop(l, 0, &row));
+  TEST_ASSERT_EQUAL(-7, row.key);
+  TEST_ASSERT_TRUE(-3.5 == row.value);
+
+  TEST_ASSERT_EQUAL(ROWS_LENGTH - 1, soa_length(l));
+  TEST_ASSERT_EQUAL(1, soa_view_key(l)[0]);
+  TEST_ASSERT_TRUE(0.5 == soa_view_value(l)[0]);
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_pop(l, ROWS_LENGTH - 2, NULL));
+  TEST_ASSERT_EQUAL_ERROR(SOA_ERROR_INDEX_TOO_BIG,
+                          soa_pop(l, ROWS_LENGTH - 2, NULL));
+  TEST_ASSERT_EQUAL_ERROR(SOA_ERROR_INDEX_TOO_BIG,
+                          soa_set(l, ROWS_LENGTH - 2, &row));
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, soa_clear(l));
+  TEST_ASSERT_EQUAL(0, soa_length(l));
+}
+
+/*******************************************************************************
+ *    PRIVATE API TESTS
+ ******************************************************************************/
+void test__reserve(void) {
+  TEST_ASSERT_EQUAL_ERROR(SOA_SUCCESS, _reserve(l, 9));
+  TEST_ASSERT_EQUAL(16, l->capacity);
+
+  TEST_ASSERT_EQUAL_ERROR(SOA_ERROR_OVERFLOW, _reserve(l, SOA_SIZE_T_MAX));
+  TEST_ASSERT_EQUAL(16, l->capacity);
+}
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <stddef.h>
+
+// App
+#include "tsl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+int tsl_small_values[] = {0, 1, 2, 3, 4, 5};
+size_t tsl_small_length = sizeof(tsl_small_values) / sizeof(int);
+const size_t default_capacity = 4;
+size_t callback_counter = 0;
+tsl_ptr l = NULL;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  callback_counter = 0;
+
+  if (tsl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+
+  if (tsl_append_multi(l, tsl_small_length, tsl_small_values))
+    TEST_FAIL_MESSAGE("Unable to fill list!");
+}
+
+void tearDown(void) {
+  tsl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(tsl_error expected, tsl_error received) {
+  TEST_ASSERT_EQUAL_STRING(tsl_strerror(expected), tsl_strerror(received));
+}
+
+void dummy_callback(int _) { callback_counter++; }
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_tsl_append_multi_grows(void) {
+  TEST_ASSERT_EQUAL(tsl_small_length, tsl_length(l));
+  TEST_ASSERT_GREATER_OR_EQUAL(tsl_small_length, l->capacity);
+  TEST_ASSERT_EQUAL_INT_ARRAY(tsl_small_values, l->array, tsl_small_length);
+  // Array was replaced, old one is freed as there were no readers.
+  TEST_ASSERT_NULL(l->retired);
+  TEST_ASSERT_EQUAL(l->sequence % 2, 0);
+}
+
+void test_tsl_get_success(void) {
+  size_t i;
+  int value;
+
+  for (i = 0; i < tsl_small_length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_get(l, i, &value));
+    TEST_ASSERT_EQUAL(tsl_small_values[i], value);
+
+    TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_get_optimistic(l, i, &value));
+    TEST_ASSERT_EQUAL(tsl_small_values[i], value);
+  }
+}
+
+void test_tsl_get_i_too_big_failure(void) {
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INDEX_TOO_BIG,
+                          tsl_get(l, tsl_small_length, &value));
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INDEX_TOO_BIG,
+                          tsl_get_optimistic(l, tsl_small_length, &value));
+}
+
+void test_tsl_slice_success(void) {
+  int slice[3];
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_slice(l, 2, 3, slice));
+  TEST_ASSERT_EQUAL_INT_ARRAY(tsl_small_values + 2, slice, 3);
+}
+
+void test_tsl_slice_failure(void) {
+  int slice[10];
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INDEX_TOO_BIG,
+                          tsl_slice(l, tsl_small_length, 1, slice));
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INVALID_ARGS,
+                          tsl_slice(l, 2, tsl_small_length, slice));
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_OVERFLOW,
+                          tsl_slice(l, 2, TSL_SIZE_T_MAX, slice));
+}
+
+void test_tsl_set_multi_success(void) {
+  int values[] = {10, 11};
+  int expected[] = {0, 10, 11, 3, 4, 5};
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_set_multi(l, 1, 2, values));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, tsl_small_length);
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_set(l, 5, 50));
+  TEST_ASSERT_EQUAL(50, l->array[5]);
+}
+
+void test_tsl_set_i_too_big_failure(void) {
+  int values[] = {10, 11};
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INDEX_TOO_BIG,
+                          tsl_set(l, tsl_small_length, 1));
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INDEX_TOO_BIG,
+                          tsl_set_multi(l, tsl_small_length - 1, 2, values));
+}
+
+void test_tsl_insert_success(void) {
+  int values[] = {10, 11};
+  int expected[] = {9, 0, 10, 11, 1, 2, 3, 4, 5, 12};
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_insert(l, 0, 9));
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_insert_multi(l, 2, 2, values));
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_append(l, 12));
+
+  TEST_ASSERT_EQUAL(sizeof(expected) / sizeof(int), tsl_length(l));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, tsl_length(l));
+}
+
+void test_tsl_pop_success(void) {
+  int expected[] = {0, 2, 3, 4};
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_pop(l, 1, &value));
+  TEST_ASSERT_EQUAL(1, value);
+
+  // Index bigger than length pops the last element.
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_pop(l, 100, &value));
+  TEST_ASSERT_EQUAL(5, value);
+
+  TEST_ASSERT_EQUAL(4, tsl_length(l));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, 4);
+}
+
+void test_tsl_pop_empty_failure(void) {
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_clear(l, NULL));
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_POP_EMPTY_LIST, tsl_pop(l, 0, &value));
+}
+
+void test_tsl_pop_multi_success(void) {
+  int expected_holder[] = {2, 3, 4};
+  int expected[] = {0, 1, 5};
+  int holder[3];
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_pop_multi(l, 2, 3, holder));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected_holder, holder, 3);
+  TEST_ASSERT_EQUAL(3, tsl_length(l));
+  TEST_ASSERT_EQUAL_INT_ARRAY(expected, l->array, 3);
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_INVALID_ARGS,
+                          tsl_pop_multi(l, 1, 3, holder));
+}
+
+void test_tsl_remove_and_clear_callbacks(void) {
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_remove(l, 0, dummy_callback));
+  TEST_ASSERT_EQUAL(1, callback_counter);
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_clear(l, dummy_callback));
+  TEST_ASSERT_EQUAL(tsl_small_length, callback_counter);
+  TEST_ASSERT_EQUAL(0, tsl_length(l));
+}
+
+void test_tsl_snapshot_is_not_modified(void) {
+  struct tsl_snapshot snapshot;
+  int more_values[] = {6, 7, 8, 9, 10, 11, 12, 13};
+  int value;
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_acquire(l, &snapshot));
+  TEST_ASSERT_EQUAL(tsl_small_length, snapshot.length);
+
+  // Each kind of write has to leave snapshot's array untouched.
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_set(l, 0, 100));
+  TEST_ASSERT_EQUAL_INT_ARRAY(tsl_small_values, snapshot.array,
+                              tsl_small_length);
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_release(l, &snapshot));
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_acquire(l, &snapshot));
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_insert(l, 0, 101));
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_pop(l, 3, &value));
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_append_multi(l, 8, more_values));
+  TEST_ASSERT_EQUAL(100, snapshot.array[0]);
+  TEST_ASSERT_EQUAL_INT_ARRAY(tsl_small_values + 1, snapshot.array + 1,
+                              tsl_small_length - 1);
+  // Replaced arrays are kept while snapshot is held.
+  TEST_ASSERT_NOT_NULL(l->retired);
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_release(l, &snapshot));
+  TEST_ASSERT_NULL(snapshot.array);
+  TEST_ASSERT_NULL(l->retired);
+  TEST_ASSERT_EQUAL(tsl_small_length + 8, tsl_length(l));
+}
+
+void test_tsl_snapshot_without_writes_is_free(void) {
+  struct tsl_snapshot snapshot;
+  TSL_VALUE_TYPE *array = l->array;
+
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_acquire(l, &snapshot));
+  TEST_ASSERT_EQUAL_PTR(array, snapshot.array);
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_snapshot_release(l, &snapshot));
+
+  // Pinned array is copied once, following writes go to the copy.
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_set(l, 0, 100));
+  array = l->array;
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_set(l, 1, 101));
+  TEST_ASSERT_EQUAL_PTR(array, l->array);
+  TEST_ASSERT_NULL(l->retired);
+}
+
+void test_tsl_snapshots_exhausted_failure(void) {
+  struct tsl_snapshot snapshots[TSL_READERS_MAX + 1];
+  size_t i;
+  int value;
+
+  for (i = 0; i < TSL_READERS_MAX; i++) {
+    TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS,
+                            tsl_snapshot_acquire(l, &snapshots[i]));
+  }
+  TEST_ASSERT_EQUAL_ERROR(TSL_ERROR_SNAPSHOTS_EXHAUSTED,
+                          tsl_snapshot_acquire(l, &snapshots[i]));
+  // Optimistic get falls back to the lock.
+  TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS, tsl_get_optimistic(l, 1, &value));
+  TEST_ASSERT_EQUAL(1, value);
+
+  for (i = 0; i < TSL_READERS_MAX; i++) {
+    TEST_ASSERT_EQUAL_ERROR(TSL_SUCCESS,
+                            tsl_snapshot_release(l, &snapshots[i]));
+  }
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS TESTS
+ ******************************************************************************/
+void test_tsl_errors_string_matching(void) {
+  TEST_ASSERT_EQUAL_MESSAGE(
+      TSL_ERROR_LEN, TSL_ERROR_STRINGS_LEN,
+      "Each error needs to have matching pair in TSL_ERROR_STRINGS.");
+}
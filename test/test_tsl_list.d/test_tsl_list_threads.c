@@ -0,0 +1,209 @@
+/* Stress tests, meant to be run under ThreadSanitizer.
+ *
+ * Writers only append and pop batches of `BATCH_LEN` equal values, always
+ *  from the list's beginning. So at any moment every aligned group of
+ *  `BATCH_LEN` elements holds one value. If reader ever sees a group holding
+ *  different values, some batch was not atomic.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+
+// App
+#include "tsl_list.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define WRITERS_AMOUNT 2
+#define READERS_AMOUNT 4
+#define BATCH_LEN 4
+#define ITERATIONS 2000
+
+const size_t default_capacity = 1;
+tsl_ptr l = NULL;
+
+struct writer_result {
+  size_t appended;
+  size_t popped;
+  size_t broken_batches;
+};
+
+struct reader_result {
+  size_t broken_batches;
+  size_t invalid_values;
+};
+
+volatile int writers_done = 0;
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  writers_done = 0;
+
+  if (tsl_create(&l, default_capacity))
+    TEST_FAIL_MESSAGE("Unable to create list!");
+}
+
+void tearDown(void) {
+  tsl_destroy(l);
+
+  l = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+bool is_batch(int values[]) {
+  size_t i;
+
+  for (i = 1; i < BATCH_LEN; i++) {
+    if (values[i] != values[0])
+      return false;
+  }
+
+  return true;
+}
+
+void *writer(void *arg) {
+  struct writer_result *result = arg;
+  int batch[BATCH_LEN], holder[BATCH_LEN];
+  size_t i, k;
+
+  for (i = 0; i < ITERATIONS; i++) {
+    for (k = 0; k < BATCH_LEN; k++) {
+      batch[k] = (int)i;
+    }
+
+    if (tsl_append_multi(l, BATCH_LEN, batch) == TSL_SUCCESS)
+      result->appended++;
+
+    if (i % 2 && tsl_pop_multi(l, 0, BATCH_LEN, holder) == TSL_SUCCESS) {
+      result->popped++;
+      if (!is_batch(holder))
+        result->broken_batches++;
+    }
+  }
+
+  return NULL;
+}
+
+void *reader(void *arg) {
+  struct reader_result *result = arg;
+  int slice[BATCH_LEN], value;
+  size_t groups, i = 0;
+
+  while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+    groups = tsl_length(l) / BATCH_LEN;
+    if (groups == 0) {
+      sched_yield();
+      continue;
+    }
+
+    i = (i + 7) % groups;
+
+    if (tsl_slice(l, i * BATCH_LEN, BATCH_LEN, slice) == TSL_SUCCESS &&
+        !is_batch(slice))
+      result->broken_batches++;
+
+    if (tsl_get_optimistic(l, i * BATCH_LEN, &value) == TSL_SUCCESS &&
+        (value < 0 || value >= ITERATIONS))
+      result->invalid_values++;
+  }
+
+  return NULL;
+}
+
+void *snapshot_reader(void *arg) {
+  struct reader_result *result = arg;
+  struct tsl_snapshot snapshot;
+  size_t i, k, sum, sum_again;
+
+  while (!__atomic_load_n(&writers_done, __ATOMIC_ACQUIRE)) {
+    if (tsl_snapshot_acquire(l, &snapshot)) {
+      sched_yield();
+      continue;
+    }
+
+    // Whole snapshot is consistent, not only single batches.
+    if (snapshot.length % BATCH_LEN)
+      result->broken_batches++;
+
+    sum = 0;
+    for (i = 0; i + BATCH_LEN <= snapshot.length; i += BATCH_LEN) {
+      for (k = 0; k < BATCH_LEN; k++) {
+        if (snapshot.array[i + k] != snapshot.array[i])
+          result->broken_batches++;
+        sum += (size_t)snapshot.array[i + k];
+      }
+    }
+
+    sched_yield();
+
+    // Writers did not touch snapshot's array meanwhile.
+    sum_again = 0;
+    for (i = 0; i < snapshot.length; i++) {
+      sum_again += (size_t)snapshot.array[i];
+    }
+    if (sum != sum_again)
+      result->invalid_values++;
+
+    tsl_snapshot_release(l, &snapshot);
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_tsl_batches_are_atomic(void) {
+  struct writer_result writers_results[WRITERS_AMOUNT] = {0};
+  struct reader_result readers_results[READERS_AMOUNT] = {0};
+  pthread_t writers[WRITERS_AMOUNT], readers[READERS_AMOUNT];
+  size_t appended = 0, popped = 0, i;
+  int holder[BATCH_LEN];
+
+  for (i = 0; i < READERS_AMOUNT; i++) {
+    pthread_create(&readers[i], NULL, i % 2 ? snapshot_reader : reader,
+                   &readers_results[i]);
+  }
+  for (i = 0; i < WRITERS_AMOUNT; i++) {
+    pthread_create(&writers[i], NULL, writer, &writers_results[i]);
+  }
+
+  for (i = 0; i < WRITERS_AMOUNT; i++) {
+    pthread_join(writers[i], NULL);
+    TEST_ASSERT_EQUAL(0, writers_results[i].broken_batches);
+    appended += writers_results[i].appended;
+    popped += writers_results[i].popped;
+  }
+
+  __atomic_store_n(&writers_done, 1, __ATOMIC_RELEASE);
+
+  for (i = 0; i < READERS_AMOUNT; i++) {
+    pthread_join(readers[i], NULL);
+    TEST_ASSERT_EQUAL(0, readers_results[i].broken_batches);
+    TEST_ASSERT_EQUAL(0, readers_results[i].invalid_values);
+  }
+
+  TEST_ASSERT_EQUAL(WRITERS_AMOUNT * ITERATIONS, appended);
+  TEST_ASSERT_EQUAL((appended - popped) * BATCH_LEN, tsl_length(l));
+
+  while (tsl_pop_multi(l, 0, BATCH_LEN, holder) == TSL_SUCCESS) {
+    TEST_ASSERT_TRUE(is_batch(holder));
+  }
+  TEST_ASSERT_EQUAL(0, tsl_length(l));
+}
@@ -0,0 +1,276 @@
+/* Scheduler tests, meant to be run under ThreadSanitizer.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+/*******************************************************************************
+ *    IMPORTS
+ ******************************************************************************/
+// C standard library
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+
+// App
+#include "wks_sched.c"
+
+// Test framework
+#include <unity.h>
+
+/*******************************************************************************
+ *    TESTS DATA
+ ******************************************************************************/
+#define WORKERS_AMOUNT 4
+#define VALUES_LENGTH 100000
+
+struct fib_arg {
+  wks_ptr s;
+  size_t n;
+  size_t result;
+};
+
+wks_ptr s = NULL;
+unsigned char visited[VALUES_LENGTH];
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {
+  if (wks_create(&s, WORKERS_AMOUNT))
+    TEST_FAIL_MESSAGE("Unable to create scheduler!");
+
+  memset(visited, 0, sizeof(visited));
+}
+
+void tearDown(void) {
+  wks_destroy(s);
+
+  s = NULL;
+}
+
+/*******************************************************************************
+ *    TESTS UTILS
+ ******************************************************************************/
+void TEST_ASSERT_EQUAL_ERROR(wks_error expected, wks_error received) {
+  TEST_ASSERT_EQUAL_STRING(wks_strerror(expected), wks_strerror(received));
+}
+
+/* Recursive fork/join, the classic work stealing exercise. */
+void fib(void *arg) {
+  struct fib_arg *fib_arg = arg, left, right;
+  struct wks_group group;
+
+  if (fib_arg->n < 2) {
+    fib_arg->result = fib_arg->n;
+    return;
+  }
+
+  left.s = right.s = fib_arg->s;
+  left.n = fib_arg->n - 1;
+  right.n = fib_arg->n - 2;
+
+  // Unity's asserts cannot be used by workers, failed spawn is
+  //  computed in place.
+  wks_group_init(&group);
+  if (wks_spawn(fib_arg->s, &group, fib, &left))
+    fib(&left);
+  fib(&right);
+  wks_wait(fib_arg->s, &group);
+
+  fib_arg->result = left.result + right.result;
+}
+
+void visit(size_t start, size_t end, void *arg) {
+  size_t i, *calls = arg;
+
+  for (i = start; i < end; i++) {
+    visited[i]++;
+  }
+
+  __atomic_add_fetch(calls, 1, __ATOMIC_RELAXED);
+}
+
+struct nested_arg {
+  wks_ptr s;
+  size_t calls;
+};
+
+void nested_for(size_t start, size_t end, void *arg) {
+  struct nested_arg *nested_arg = arg;
+  size_t calls = 0;
+
+  // Loop inside of a loop, waiting worker keeps executing tasks.
+  wks_parallel_for(nested_arg->s, start * 100, end * 100, 10, visit, &calls);
+  __atomic_add_fetch(&nested_arg->calls, calls, __ATOMIC_RELAXED);
+}
+
+struct waiter_arg {
+  int ran_by_worker;
+  int slept;
+};
+
+/* Returns once waiting thread went to sleep, or gives up after a while. */
+void wait_for_sleeping_waiter(void *arg) {
+  struct waiter_arg *waiter_arg = arg;
+  size_t i;
+
+  waiter_arg->ran_by_worker = _current_worker != NULL;
+
+  for (i = 0; i < 1000000 && waiter_arg->ran_by_worker; i++) {
+    if (__atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST)) {
+      waiter_arg->slept = 1;
+      return;
+    }
+    sched_yield();
+  }
+}
+
+void *external_spawner(void *arg) {
+  struct fib_arg *fib_arg = arg;
+  struct wks_group group;
+
+  wks_group_init(&group);
+  wks_spawn(fib_arg->s, &group, fib, fib_arg);
+  wks_wait(fib_arg->s, &group);
+
+  return NULL;
+}
+
+/*******************************************************************************
+ *    PUBLIC API TESTS
+ ******************************************************************************/
+void test_wks_fork_join_success(void) {
+  struct fib_arg arg = {.s = s, .n = 20};
+
+  fib(&arg);
+
+  TEST_ASSERT_EQUAL(6765, arg.result);
+}
+
+void test_wks_spawn_from_many_threads(void) {
+  struct fib_arg args[3] = {
+      {.s = s, .n = 15}, {.s = s, .n = 16}, {.s = s, .n = 17}};
+  pthread_t threads[3];
+  size_t i;
+
+  for (i = 0; i < 3; i++) {
+    pthread_create(&threads[i], NULL, external_spawner, &args[i]);
+  }
+  for (i = 0; i < 3; i++) {
+    pthread_join(threads[i], NULL);
+  }
+
+  TEST_ASSERT_EQUAL(610, args[0].result);
+  TEST_ASSERT_EQUAL(987, args[1].result);
+  TEST_ASSERT_EQUAL(1597, args[2].result);
+}
+
+void test_wks_parallel_for_visits_each_once(void) {
+  size_t grains[] = {0, 1, 7, 1000, VALUES_LENGTH * 2};
+  size_t calls, i, k;
+
+  for (k = 0; k < sizeof(grains) / sizeof(size_t); k++) {
+    memset(visited, 0, sizeof(visited));
+    calls = 0;
+
+    TEST_ASSERT_EQUAL_ERROR(WKS_SUCCESS, wks_parallel_for(s, 0, VALUES_LENGTH,
+                                                          grains[k], visit,
+                                                          &calls));
+
+    for (i = 0; i < VALUES_LENGTH; i++) {
+      TEST_ASSERT_EQUAL(1, visited[i]);
+    }
+    // Each call processes at most a grain.
+    if (grains[k])
+      TEST_ASSERT_TRUE(calls >= VALUES_LENGTH / grains[k]);
+  }
+}
+
+void test_wks_parallel_for_nested(void) {
+  struct nested_arg arg = {.s = s, .calls = 0};
+  size_t i;
+
+  TEST_ASSERT_EQUAL_ERROR(
+      WKS_SUCCESS, wks_parallel_for(s, 0, VALUES_LENGTH / 100, 1, nested_for,
+                                    &arg));
+
+  for (i = 0; i < VALUES_LENGTH; i++) {
+    TEST_ASSERT_EQUAL(1, visited[i]);
+  }
+  // Each call processes at most a grain.
+  TEST_ASSERT_TRUE(arg.calls >= VALUES_LENGTH / 10);
+}
+
+void test_wks_wait_sleeps_outside_of_workers(void) {
+  struct waiter_arg arg = {0, 0};
+  struct wks_group group;
+
+  wks_group_init(&group);
+  TEST_ASSERT_EQUAL_ERROR(
+      WKS_SUCCESS, wks_spawn(s, &group, wait_for_sleeping_waiter, &arg));
+  TEST_ASSERT_EQUAL_ERROR(WKS_SUCCESS, wks_wait(s, &group));
+
+  // Main thread either ran the task itself, or slept till it was done.
+  TEST_ASSERT_TRUE(!arg.ran_by_worker || arg.slept);
+  TEST_ASSERT_EQUAL(0, s->waiters);
+}
+
+void test_wks_parallel_for_invalid_range(void) {
+  size_t calls = 0;
+
+  TEST_ASSERT_EQUAL_ERROR(WKS_ERROR_INVALID_ARGS,
+                          wks_parallel_for(s, 2, 1, 0, visit, &calls));
+  TEST_ASSERT_EQUAL_ERROR(WKS_SUCCESS,
+                          wks_parallel_for(s, 1, 1, 0, visit, &calls));
+  TEST_ASSERT_EQUAL(0, calls);
+}
+
+void test_wks_create_failure(void) {
+  wks_ptr other;
+
+  TEST_ASSERT_EQUAL_ERROR(WKS_ERROR_INVALID_ARGS,
+                          wks_create(&other, WKS_WORKERS_MAX + 1));
+}
+
+/*******************************************************************************
+ *    PRIVATE API TESTS
+ ******************************************************************************/
+void test__deque_order_and_growth(void) {
+  struct wks_task tasks[WKS_DEQUE_DEFAULT_CAPACITY * 3];
+  struct wks_worker w;
+  bool aborted = false;
+  size_t i, length = sizeof(tasks) / sizeof(struct wks_task);
+
+  TEST_ASSERT_EQUAL_ERROR(WKS_SUCCESS, _deque_init(&w));
+  TEST_ASSERT_TRUE(_deque_is_empty(&w));
+
+  for (i = 0; i < length; i++) {
+    TEST_ASSERT_EQUAL_ERROR(WKS_SUCCESS, _deque_push(&w, &tasks[i]));
+  }
+  TEST_ASSERT_TRUE(w.array->capacity >= length);
+  TEST_ASSERT_NOT_NULL(w.array->retired);
+
+  // Thieves take the oldest, owner the newest.
+  TEST_ASSERT_EQUAL_PTR(&tasks[0], _deque_steal(&w, &aborted));
+  TEST_ASSERT_EQUAL_PTR(&tasks[length - 1], _deque_take(&w));
+
+  for (i = length - 2; i > 0; i--) {
+    TEST_ASSERT_EQUAL_PTR(&tasks[i], _deque_take(&w));
+  }
+
+  TEST_ASSERT_NULL(_deque_take(&w));
+  TEST_ASSERT_NULL(_deque_steal(&w, &aborted));
+  TEST_ASSERT_FALSE(aborted);
+
+  _deque_destroy(&w);
+}
+
+/*******************************************************************************
+ *    ERRORS UTILS TESTS
+ ******************************************************************************/
+void test_wks_errors_string_matching(void) {
+  TEST_ASSERT_EQUAL_MESSAGE(
+      WKS_ERROR_LEN, WKS_ERROR_STRINGS_LEN,
+      "Each error needs to have matching pair in WKS_ERROR_STRINGS.");
+}